@@ -5,18 +5,69 @@
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
 ../src/cr_startup_lpc17.c \
+../src/fault.c \
+../src/fft.c \
+../src/histo.c \
+../src/history.c \
+../src/input.c \
+../src/ledbar.c \
 ../src/main.c \
-../src/oled_graphing.c 
+../src/memstat.c \
+../src/numfmt.c \
+../src/oled_graphing.c \
+../src/pool.c \
+../src/profile.c \
+../src/scope.c \
+../src/sensor.c \
+../src/serial.c \
+../src/spsc.c \
+../src/trace.c \
+../src/trigger.c \
+../src/vibration.c 
 
 OBJS += \
 ./src/cr_startup_lpc17.o \
+./src/fault.o \
+./src/fft.o \
+./src/histo.o \
+./src/history.o \
+./src/input.o \
+./src/ledbar.o \
 ./src/main.o \
-./src/oled_graphing.o 
+./src/memstat.o \
+./src/numfmt.o \
+./src/oled_graphing.o \
+./src/pool.o \
+./src/profile.o \
+./src/scope.o \
+./src/sensor.o \
+./src/serial.o \
+./src/spsc.o \
+./src/trace.o \
+./src/trigger.o \
+./src/vibration.o 
 
 C_DEPS += \
 ./src/cr_startup_lpc17.d \
+./src/fault.d \
+./src/fft.d \
+./src/histo.d \
+./src/history.d \
+./src/input.d \
+./src/ledbar.d \
 ./src/main.d \
-./src/oled_graphing.d 
+./src/memstat.d \
+./src/numfmt.d \
+./src/oled_graphing.d \
+./src/pool.d \
+./src/profile.d \
+./src/scope.d \
+./src/sensor.d \
+./src/serial.d \
+./src/spsc.d \
+./src/trace.d \
+./src/trigger.d \
+./src/vibration.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
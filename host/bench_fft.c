@@ -0,0 +1,45 @@
+/*****************************************************************************
+ *   Time of window + FFT + magnitude per size on the host. The same path
+ *   on the board is in fft_cycles[] (see main.c spectrum_update()).
+ *
+ ******************************************************************************/
+#include <stdio.h>
+#include <time.h>
+
+#include "fft.h"
+
+static int16_t re[FFT_MAX_N];
+static int16_t im[FFT_MAX_N];
+static uint16_t mag[FFT_MAX_N / 2];
+
+static double now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+int main(void)
+{
+	printf("%6s %12s %12s\n", "n", "ns/fft", "ns/sample");
+	for (int log2n = FFT_LOG2_MIN; log2n <= FFT_LOG2_MAX; log2n++) {
+		int n = 1 << log2n;
+		int runs = 200000 >> log2n;
+		double t0, t;
+
+		t0 = now_ns();
+		for (int r = 0; r < runs; r++) {
+			for (int i = 0; i < n; i++) {
+				re[i] = (int16_t)((i * 2654435761u) >> 17);
+				im[i] = 0;
+			}
+			fft_window(re, log2n);
+			fft_q15(re, im, log2n);
+			fft_magnitude(re, im, mag, n / 2);
+		}
+		t = (now_ns() - t0) / runs;
+		printf("%6d %12.0f %12.1f\n", n, t, t / n);
+	}
+	return 0;
+}
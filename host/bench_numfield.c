@@ -0,0 +1,154 @@
+/*****************************************************************************
+ *   Live value update on the host OLED model: the old intToString() +
+ *   oled_fillRect() + oled_putString() path of show_value() against
+ *   fmt_*() + numfield_show(). Bytes are what goes over SSP to the
+ *   display (oled_bytes), which is what the update costs on the board.
+ *
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "oled_graphing.h"
+#include "numfmt.h"
+#include "font5x7.h"
+
+#define UPDATES 20000
+#define VALUE_X 60			// sensors[].value_x of the live graph
+
+static uint8_t buf[FMT_BUF];
+static int32_t seq[UPDATES];
+static numfield_t f;
+
+static double now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/* main.c before numfmt.c, from the EA examples */
+static void intToString(int value, uint8_t* pBuf, uint32_t len, uint32_t base)
+{
+	static const char* pAscii = "0123456789abcdefghijklmnopqrstuvwxyz";
+	int pos = 0;
+	int tmpValue = value;
+
+	if (pBuf == NULL || len < 2)
+		return;
+	if (base < 2 || base > 36)
+		return;
+	if (value < 0) {
+		tmpValue = -tmpValue;
+		value = -value;
+		pBuf[pos++] = '-';
+	}
+	do {
+		pos++;
+		tmpValue /= base;
+	} while (tmpValue > 0);
+	if (pos > len)
+		return;
+	pBuf[pos] = '\0';
+	do {
+		pBuf[--pos] = pAscii[value % base];
+		value /= base;
+	} while (value > 0);
+}
+
+/* show_value() before numfield_t, which also redrew the title */
+static void old_show(int32_t value, int tenths)
+{
+	oled_putString(1, 1, (uint8_t*)"Temp:", OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+	intToString(tenths ? value / 10 : value, buf, 10, 10);
+	oled_fillRect(VALUE_X, 0, 95, 8, OLED_COLOR_WHITE);
+	oled_putString(VALUE_X, 1, buf, OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+}
+
+static void new_show(int32_t value, int tenths)
+{
+	if (tenths)
+		numfield_show(&f, buf, fmt_tenths(value, buf));
+	else
+		numfield_show(&f, buf, fmt_i32(value, buf));
+}
+
+static void run(const char* name, int tenths)
+{
+	void (*show[2])(int32_t, int) = { old_show, new_show };
+	const char* path[2] = { "old", "numfield" };
+
+	for (int p = 0; p < 2; p++) {
+		uint32_t bytes, pixels;
+		double t0, t;
+
+		oled_init();
+		oled_clearScreen(OLED_COLOR_WHITE);
+		numfield_init(&f, VALUE_X, 1, (OLED_DISPLAY_WIDTH - VALUE_X) / 6,
+				OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+		bytes = oled_bytes;
+		pixels = oled_pixels_written;
+		t0 = now_ns();
+		for (int i = 0; i < UPDATES; i++)
+			show[p](seq[i], tenths);
+		t = (now_ns() - t0) / UPDATES;
+		pixels = oled_pixels_written - pixels;
+		bytes = oled_bytes - bytes;
+		printf("%-10s %-9s %10.0f %10.1f %10.1f\n", name, path[p], t,
+				(double)pixels / UPDATES, (double)bytes / UPDATES);
+	}
+}
+
+/* pixels a cell rewrites going from glyph a to glyph b */
+static int diff(uint8_t a, uint8_t b)
+{
+	int n = 0;
+
+	for (int r = 0; r < 8; r++)
+		n += __builtin_popcount(font5x7[a - 0x20][r] ^ font5x7[b - 0x20][r]);
+	return n;
+}
+
+int main(void)
+{
+	int32_t v;
+	int sum = 0, most = 0;
+
+	printf("%-10s %-9s %10s %10s %10s\n", "values", "path", "ns/update",
+			"px/update", "B/update");
+
+	// temperature in tenths, drifting by at most 0.1 per sample
+	srand(1);
+	v = 250;
+	for (int i = 0; i < UPDATES; i++) {
+		v += rand() % 3 - 1;
+		seq[i] = v;
+	}
+	run("temp", 1);
+
+	// a counter, mostly the last digit changes
+	for (int i = 0; i < UPDATES; i++)
+		seq[i] = i;
+	run("count", 0);
+
+	// trimpot codes in any order, every digit changes
+	for (int i = 0; i < UPDATES; i++)
+		seq[i] = rand() % 4096;
+	run("random", 0);
+
+	// digit to digit, against the 48 pixels of oled_putChar()
+	for (uint8_t a = '0'; a <= '9'; a++) {
+		for (uint8_t b = '0'; b <= '9'; b++) {
+			if (a == b)
+				continue;
+			v = diff(a, b);
+			sum += v;
+			if (v > most)
+				most = v;
+		}
+	}
+	printf("\ndigit change: %.1f px mean, %d max, '1' to '8' %d, putChar 48\n",
+			sum / 90.0, most, diff('1', '8'));
+	return 0;
+}
@@ -0,0 +1,58 @@
+/*****************************************************************************
+ *   Base board drivers and firmware services that do nothing on the host,
+ *   for host builds of src/main.c (replay.c, test_sensor_table.c). Those builds
+ *   supply the reads, input and timing themselves.
+ *
+ ******************************************************************************/
+#include <stddef.h>
+
+#include "lpc17xx_gpio.h"
+#include "lpc17xx_ssp.h"
+#include "temp.h"
+#include "light.h"
+#include "joystick.h"
+#include "rotary.h"
+#include "led7seg.h"
+#include "pca9532.h"
+#include "vibration.h"
+#include "serial.h"
+#include "memstat.h"
+#include "fault.h"
+
+void vib_init(void) {}
+void temp_init(uint32_t (*getMsTicks)(void)) { (void)getMsTicks; }
+void light_init(void) {}
+void light_enable(void) {}
+void light_setRange(light_range_t newRange) { (void)newRange; }
+void joystick_init(void) {}
+void rotary_init(void) {}
+void led7seg_init(void) { GPIO_SetValue(2, 1 << 2); }
+
+/* one byte over SSP1 with the 7-segment selected (P2.2), which the display
+ * count must leave out */
+void led7seg_setChar(uint8_t ch, uint32_t rawMode)
+{
+	SSP_DATA_SETUP_Type xfer = { &ch, 0, NULL, 0, 1, 0 };
+
+	(void)rawMode;
+	GPIO_ClearValue(2, 1 << 2);
+	SSP_ReadWrite(LPC_SSP1, &xfer, SSP_TRANSFER_POLLING);
+	GPIO_SetValue(2, 1 << 2);
+}
+
+void pca9532_init(void) {}
+void pca9532_setLeds(uint16_t ledOnMask, uint16_t ledOffMask) { (void)ledOnMask; (void)ledOffMask; }
+void pca9532_setBlink0Period(uint8_t period) { (void)period; }
+void pca9532_setBlink0Duty(uint8_t duty) { (void)duty; }
+void pca9532_setBlink0Leds(uint16_t ledMask) { (void)ledMask; }
+
+void serial_init(void) {}
+void serial_puts(const char* s) { (void)s; }
+
+mem_region_t mem[MEM_NUM] = { { "loc", 0, 0, 0, 0 }, { "ahb", 0, 0, 0, 0 } };
+void mem_update(void) {}
+
+fault_record_t fault_record;
+void fault_init(void) {}
+int fault_valid(void) { return fault_record.magic == FAULT_MAGIC; }
+void fault_clear(void) {}
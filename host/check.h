@@ -0,0 +1,38 @@
+/*****************************************************************************
+ *   Minimal checks for the host tests: a failed CHECK() prints where and
+ *   what, check_done() gives the exit code.
+ *
+ ******************************************************************************/
+#ifndef CHECK_H_
+#define CHECK_H_
+
+#include <stdio.h>
+
+static int check_failed;
+static int check_count;
+
+#define CHECK(cond) do { \
+		check_count++; \
+		if (!(cond)) { \
+			printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+			check_failed++; \
+		} \
+	} while (0)
+
+#define CHECK_EQ(a, b) do { \
+		long long a_ = (long long)(a), b_ = (long long)(b); \
+		check_count++; \
+		if (a_ != b_) { \
+			printf("%s:%d: %s == %s failed: %lld != %lld\n", \
+					__FILE__, __LINE__, #a, #b, a_, b_); \
+			check_failed++; \
+		} \
+	} while (0)
+
+static int check_done(const char* name)
+{
+	printf("%s: %d checks, %d failed\n", name, check_count, check_failed);
+	return check_failed ? 1 : 0;
+}
+
+#endif /* CHECK_H_ */
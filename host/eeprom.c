@@ -0,0 +1,44 @@
+/*****************************************************************************
+ *   Host model of the EA base board EEPROM driver: erased memory reads as
+ *   all ones, transfers beyond the end are cut short like the real one.
+ *
+ ******************************************************************************/
+#include <string.h>
+
+#include "eeprom.h"
+
+uint8_t eeprom_mem[EEPROM_TOTAL_SIZE];
+int32_t eeprom_reads_left = -1;
+
+void eeprom_init(void)
+{
+	memset(eeprom_mem, 0xFF, sizeof(eeprom_mem));
+	eeprom_reads_left = -1;
+}
+
+static uint16_t clip(uint16_t offset, uint16_t len)
+{
+	if (offset >= EEPROM_TOTAL_SIZE)
+		return 0;
+	if (len > EEPROM_TOTAL_SIZE - offset)
+		return EEPROM_TOTAL_SIZE - offset;
+	return len;
+}
+
+int16_t eeprom_read(uint8_t* buf, uint16_t offset, uint16_t len)
+{
+	if (eeprom_reads_left == 0)
+		return 0;
+	if (eeprom_reads_left > 0)
+		eeprom_reads_left--;
+	len = clip(offset, len);
+	memcpy(buf, eeprom_mem + offset, len);
+	return (int16_t)len;
+}
+
+int16_t eeprom_write(uint8_t* buf, uint16_t offset, uint16_t len)
+{
+	len = clip(offset, len);
+	memcpy(eeprom_mem + offset, buf, len);
+	return (int16_t)len;
+}
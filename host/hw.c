@@ -0,0 +1,137 @@
+/*****************************************************************************
+ *   Host side of the peripheral stand-ins in include/: register blocks in
+ *   host memory and no-op driver calls. Models with behavior of their own
+ *   (display, EEPROM, ...) live in their own files.
+ *
+ ******************************************************************************/
+#include <time.h>
+
+#include "LPC17xx.h"
+#include "system_LPC17xx.h"
+#include "lpc17xx_adc.h"
+#include "lpc17xx_gpdma.h"
+#include "lpc17xx_gpio.h"
+#include "lpc17xx_i2c.h"
+#include "lpc17xx_pinsel.h"
+#include "lpc17xx_ssp.h"
+#include "dwt.h"
+
+LPC_ADC_TypeDef host_adc;
+LPC_GPIOINT_TypeDef host_gpioint;
+LPC_SSP_TypeDef host_ssp[2];
+LPC_I2C_TypeDef host_i2c[3];
+LPC_UART_TypeDef host_uart[4];
+LPC_TIM_TypeDef host_tim[4];
+
+uint32_t SystemCoreClock = 100000000;
+
+/* FIOPIN of ports 0..4 as last written */
+static uint32_t host_pins[5];
+
+volatile uint32_t host_dwt_ctrl;
+volatile uint32_t host_scb_demcr;
+
+/* i2c_bus.h, owned by vibration.c on the board */
+volatile uint8_t i2c_bus_busy;
+volatile uint8_t i2c_bus_acc;
+
+void SystemInit(void) {}
+
+void NVIC_EnableIRQ(IRQn_Type irq) { (void)irq; }
+void NVIC_DisableIRQ(IRQn_Type irq) { (void)irq; }
+void NVIC_SetPriority(IRQn_Type irq, uint32_t priority) { (void)irq; (void)priority; }
+void NVIC_ClearPendingIRQ(IRQn_Type irq) { (void)irq; }
+void __disable_irq(void) {}
+void __enable_irq(void) {}
+
+uint32_t SysTick_Config(uint32_t ticks)
+{
+	(void)ticks;
+	return 0;
+}
+
+volatile uint32_t* host_cyccnt(void)
+{
+	static volatile uint32_t cyccnt;
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	cyccnt = (uint32_t)(ts.tv_sec * 1000000000ull + ts.tv_nsec);
+	return &cyccnt;
+}
+
+void PINSEL_ConfigPin(PINSEL_CFG_Type* PinCfg) { (void)PinCfg; }
+
+void GPIO_SetDir(uint8_t portNum, uint32_t bitValue, uint8_t dir)
+{
+	(void)portNum; (void)bitValue; (void)dir;
+}
+void GPIO_SetValue(uint8_t portNum, uint32_t bitValue) { host_pins[portNum] |= bitValue; }
+void GPIO_ClearValue(uint8_t portNum, uint32_t bitValue) { host_pins[portNum] &= ~bitValue; }
+uint32_t GPIO_ReadValue(uint8_t portNum) { return host_pins[portNum]; }
+
+void I2C_Init(LPC_I2C_TypeDef* I2Cx, uint32_t clockrate) { (void)I2Cx; (void)clockrate; }
+void I2C_Cmd(LPC_I2C_TypeDef* I2Cx, FunctionalState NewState) { (void)I2Cx; (void)NewState; }
+
+void SSP_ConfigStructInit(SSP_CFG_Type* SSP_InitStruct) { (void)SSP_InitStruct; }
+void SSP_Init(LPC_SSP_TypeDef* SSPx, SSP_CFG_Type* SSP_ConfigStruct)
+{
+	(void)SSPx; (void)SSP_ConfigStruct;
+}
+void SSP_Cmd(LPC_SSP_TypeDef* SSPx, FunctionalState NewState) { (void)SSPx; (void)NewState; }
+
+/* the bytes go nowhere; a build linked with --wrap=SSP_ReadWrite counts
+ * them in oled_graphing.c on the way */
+int32_t SSP_ReadWrite(LPC_SSP_TypeDef* SSPx, SSP_DATA_SETUP_Type* dataCfg,
+		SSP_TRANSFER_Type xfType)
+{
+	(void)SSPx; (void)xfType;
+	dataCfg->tx_cnt = dataCfg->length;
+	return (int32_t)dataCfg->length;
+}
+
+void ADC_Init(LPC_ADC_TypeDef* ADCx, uint32_t rate) { (void)ADCx; (void)rate; }
+void ADC_IntConfig(LPC_ADC_TypeDef* ADCx, ADC_CHANNEL_SELECTION IntType, FunctionalState NewState)
+{
+	(void)ADCx; (void)IntType; (void)NewState;
+}
+void ADC_ChannelCmd(LPC_ADC_TypeDef* ADCx, uint8_t Channel, FunctionalState NewState)
+{
+	(void)ADCx; (void)Channel; (void)NewState;
+}
+void ADC_StartCmd(LPC_ADC_TypeDef* ADCx, uint8_t start_mode) { (void)ADCx; (void)start_mode; }
+void ADC_BurstCmd(LPC_ADC_TypeDef* ADCx, FunctionalState NewState) { (void)ADCx; (void)NewState; }
+
+FlagStatus ADC_ChannelGetStatus(LPC_ADC_TypeDef* ADCx, uint8_t channel, uint32_t StatusType)
+{
+	(void)ADCx; (void)channel; (void)StatusType;
+	return SET;
+}
+
+uint16_t ADC_ChannelGetData(LPC_ADC_TypeDef* ADCx, uint8_t channel)
+{
+	return (uint16_t)((ADCx->ADDR[channel] >> 4) & 0xFFF);
+}
+
+uint32_t host_dma_size;
+uint8_t host_dma_tc;
+
+void GPDMA_Init(void) {}
+Status GPDMA_Setup(GPDMA_Channel_CFG_Type* GPDMAChannelConfig)
+{
+	host_dma_size = GPDMAChannelConfig->TransferSize;
+	host_dma_tc = 0;
+	return SUCCESS;
+}
+void GPDMA_ChannelCmd(uint8_t channelNum, FunctionalState NewState) { (void)channelNum; (void)NewState; }
+IntStatus GPDMA_IntGetStatus(uint32_t type, uint8_t channel)
+{
+	(void)channel;
+	return (type == GPDMA_STAT_INTTC && host_dma_tc) ? SET : RESET;
+}
+void GPDMA_ClearIntPending(uint32_t type, uint8_t channel)
+{
+	(void)channel;
+	if (type == GPDMA_STATCLR_INTTC)
+		host_dma_tc = 0;
+}
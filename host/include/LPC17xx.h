@@ -0,0 +1,76 @@
+/*****************************************************************************
+ *   Host stand-in for LPC17xx.h. Peripherals are plain structs in host
+ *   memory (see hw.c) holding only the registers the firmware touches;
+ *   the core functions are no-ops or hooks of the harness.
+ *
+ ******************************************************************************/
+#ifndef __LPC17xx_H__
+#define __LPC17xx_H__
+
+#include "lpc_types.h"
+
+typedef enum {
+	TIMER0_IRQn = 1,
+	TIMER1_IRQn = 2,
+	UART3_IRQn = 8,
+	I2C2_IRQn = 12,
+	EINT3_IRQn = 21,
+	ADC_IRQn = 22,
+	DMA_IRQn = 26
+} IRQn_Type;
+
+typedef struct {
+	volatile uint32_t ADCR;
+	volatile uint32_t ADGDR;
+	volatile uint32_t ADINTEN;
+	volatile uint32_t ADDR[8];
+} LPC_ADC_TypeDef;
+
+typedef struct {
+	volatile uint32_t IntStatus;
+	volatile uint32_t IO0IntStatR;
+	volatile uint32_t IO0IntStatF;
+	volatile uint32_t IO0IntClr;
+	volatile uint32_t IO0IntEnR;
+	volatile uint32_t IO0IntEnF;
+	volatile uint32_t IO2IntStatR;
+	volatile uint32_t IO2IntStatF;
+	volatile uint32_t IO2IntClr;
+	volatile uint32_t IO2IntEnR;
+	volatile uint32_t IO2IntEnF;
+} LPC_GPIOINT_TypeDef;
+
+typedef struct { volatile uint32_t CR0; } LPC_SSP_TypeDef;
+typedef struct { volatile uint32_t I2CONSET; } LPC_I2C_TypeDef;
+typedef struct { volatile uint32_t LSR; } LPC_UART_TypeDef;
+typedef struct { volatile uint32_t IR; } LPC_TIM_TypeDef;
+
+extern LPC_ADC_TypeDef host_adc;
+extern LPC_GPIOINT_TypeDef host_gpioint;
+extern LPC_SSP_TypeDef host_ssp[2];
+extern LPC_I2C_TypeDef host_i2c[3];
+extern LPC_UART_TypeDef host_uart[4];
+extern LPC_TIM_TypeDef host_tim[4];
+
+#define LPC_ADC (&host_adc)
+#define LPC_GPIOINT (&host_gpioint)
+#define LPC_SSP0 (&host_ssp[0])
+#define LPC_SSP1 (&host_ssp[1])
+#define LPC_I2C2 (&host_i2c[2])
+#define LPC_UART3 ((LPC_UART_TypeDef*)&host_uart[3])
+#define LPC_TIM0 (&host_tim[0])
+#define LPC_TIM1 (&host_tim[1])
+
+extern uint32_t SystemCoreClock;
+
+void NVIC_EnableIRQ(IRQn_Type irq);
+void NVIC_DisableIRQ(IRQn_Type irq);
+void NVIC_SetPriority(IRQn_Type irq, uint32_t priority);
+void NVIC_ClearPendingIRQ(IRQn_Type irq);
+void NVIC_SystemReset(void);
+uint32_t SysTick_Config(uint32_t ticks);
+void __WFI(void);
+void __disable_irq(void);
+void __enable_irq(void);
+
+#endif /* __LPC17xx_H__ */
@@ -0,0 +1,20 @@
+/*****************************************************************************
+ *   Host stand-in for the DWT and DEMCR registers of profile.h, forced in
+ *   with -include: the cycle counter reads the host clock in ns, so
+ *   prof[] and the trace counters come out in host nanoseconds.
+ *
+ ******************************************************************************/
+#ifndef DWT_H_
+#define DWT_H_
+
+#include <stdint.h>
+
+extern volatile uint32_t host_dwt_ctrl;
+extern volatile uint32_t host_scb_demcr;
+volatile uint32_t* host_cyccnt(void);
+
+#define DWT_CTRL (host_dwt_ctrl)
+#define DWT_CYCCNT (*host_cyccnt())
+#define SCB_DEMCR (host_scb_demcr)
+
+#endif /* DWT_H_ */
@@ -0,0 +1,22 @@
+/*****************************************************************************
+ *   Host stand-in for the EA base board eeprom.h (24LC128). eeprom.c keeps
+ *   the contents in host memory.
+ *
+ ******************************************************************************/
+#ifndef __EEPROM_H
+#define __EEPROM_H
+
+#include "lpc_types.h"
+
+#define EEPROM_TOTAL_SIZE 16384
+
+void eeprom_init(void);
+int16_t eeprom_read(uint8_t* buf, uint16_t offset, uint16_t len);
+int16_t eeprom_write(uint8_t* buf, uint16_t offset, uint16_t len);
+
+/* host only: the memory, and a read that fails once the count runs out
+ * (-1 never fails) */
+extern uint8_t eeprom_mem[EEPROM_TOTAL_SIZE];
+extern int32_t eeprom_reads_left;
+
+#endif /* __EEPROM_H */
@@ -0,0 +1,110 @@
+/*****************************************************************************
+ *   Host stand-in for the EA font5x7.h: one byte per row, the leftmost
+ *   pixel in bit 7. Digits and the characters of numeric fields are the
+ *   real glyphs; every other character is a hollow box, which costs the
+ *   same to draw.
+ *
+ ******************************************************************************/
+#ifndef __FONT5X7_H
+#define __FONT5X7_H
+
+static const unsigned char font5x7[96][8] = {
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },	// space
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// !
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// "
+	{ 0x50, 0x50, 0xf8, 0x50, 0xf8, 0x50, 0x50, 0x00 },	// #
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// $
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// %
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// &
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// '
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// (
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// )
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// *
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// +
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// ,
+	{ 0x00, 0x00, 0x00, 0xf8, 0x00, 0x00, 0x00, 0x00 },	// -
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0x60, 0x00 },	// .
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// /
+	{ 0x70, 0x88, 0x98, 0xa8, 0xc8, 0x88, 0x70, 0x00 },	// 0
+	{ 0x20, 0x60, 0x20, 0x20, 0x20, 0x20, 0x70, 0x00 },	// 1
+	{ 0x70, 0x88, 0x08, 0x10, 0x20, 0x40, 0xf8, 0x00 },	// 2
+	{ 0xf8, 0x10, 0x20, 0x10, 0x08, 0x88, 0x70, 0x00 },	// 3
+	{ 0x10, 0x30, 0x50, 0x90, 0xf8, 0x10, 0x10, 0x00 },	// 4
+	{ 0xf8, 0x80, 0xf0, 0x08, 0x08, 0x88, 0x70, 0x00 },	// 5
+	{ 0x30, 0x40, 0x80, 0xf0, 0x88, 0x88, 0x70, 0x00 },	// 6
+	{ 0xf8, 0x08, 0x10, 0x20, 0x40, 0x40, 0x40, 0x00 },	// 7
+	{ 0x70, 0x88, 0x88, 0x70, 0x88, 0x88, 0x70, 0x00 },	// 8
+	{ 0x70, 0x88, 0x88, 0x78, 0x08, 0x10, 0x60, 0x00 },	// 9
+	{ 0x00, 0x60, 0x60, 0x00, 0x60, 0x60, 0x00, 0x00 },	// :
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// ;
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// <
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// =
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// >
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// ?
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// @
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// A
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// B
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// C
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// D
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// E
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// F
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// G
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// H
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// I
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// J
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// K
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// L
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// M
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// N
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// O
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// P
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// Q
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// R
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// S
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// T
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// U
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// V
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// W
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// X
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// Y
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// Z
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// [
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// backslash
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// ]
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// ^
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// _
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// `
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// a
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// b
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// c
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// d
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// e
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// f
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// g
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// h
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// i
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// j
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// k
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// l
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// m
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// n
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// o
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// p
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// q
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// r
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// s
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// t
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// u
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// v
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// w
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// x
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// y
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// z
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// {
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// |
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// }
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// ~
+	{ 0xf8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0x00 },	// DEL
+};
+
+#endif /* __FONT5X7_H */
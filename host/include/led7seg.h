@@ -0,0 +1,9 @@
+#ifndef __LED7SEG_H
+#define __LED7SEG_H
+
+#include "lpc_types.h"
+
+void led7seg_init(void);
+void led7seg_setChar(uint8_t ch, uint32_t rawMode);
+
+#endif /* __LED7SEG_H */
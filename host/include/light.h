@@ -0,0 +1,18 @@
+#ifndef __LIGHT_H
+#define __LIGHT_H
+
+#include "lpc_types.h"
+
+typedef enum {
+	LIGHT_RANGE_1000 = 0,
+	LIGHT_RANGE_4000,
+	LIGHT_RANGE_16000,
+	LIGHT_RANGE_64000
+} light_range_t;
+
+void light_init(void);
+void light_enable(void);
+uint32_t light_read(void);
+void light_setRange(light_range_t newRange);
+
+#endif /* __LIGHT_H */
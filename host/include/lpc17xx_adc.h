@@ -0,0 +1,35 @@
+#ifndef LPC17XX_ADC_H_
+#define LPC17XX_ADC_H_
+
+#include "LPC17xx.h"
+
+typedef enum {
+	ADC_CHANNEL_0 = 0,
+	ADC_CHANNEL_1,
+	ADC_CHANNEL_2,
+	ADC_CHANNEL_3,
+	ADC_CHANNEL_4,
+	ADC_CHANNEL_5,
+	ADC_CHANNEL_6,
+	ADC_CHANNEL_7
+} ADC_CHANNEL_SELECTION;
+
+typedef enum {
+	ADC_START_CONTINUOUS = 0,
+	ADC_START_NOW
+} ADC_START_OPT;
+
+typedef enum {
+	ADC_DATA_BURST = 0,
+	ADC_DATA_DONE
+} ADC_DATA_STATUS;
+
+void ADC_Init(LPC_ADC_TypeDef* ADCx, uint32_t rate);
+void ADC_IntConfig(LPC_ADC_TypeDef* ADCx, ADC_CHANNEL_SELECTION IntType, FunctionalState NewState);
+void ADC_ChannelCmd(LPC_ADC_TypeDef* ADCx, uint8_t Channel, FunctionalState NewState);
+void ADC_StartCmd(LPC_ADC_TypeDef* ADCx, uint8_t start_mode);
+void ADC_BurstCmd(LPC_ADC_TypeDef* ADCx, FunctionalState NewState);
+FlagStatus ADC_ChannelGetStatus(LPC_ADC_TypeDef* ADCx, uint8_t channel, uint32_t StatusType);
+uint16_t ADC_ChannelGetData(LPC_ADC_TypeDef* ADCx, uint8_t channel);
+
+#endif /* LPC17XX_ADC_H_ */
@@ -0,0 +1,36 @@
+#ifndef LPC17XX_GPDMA_H_
+#define LPC17XX_GPDMA_H_
+
+#include "LPC17xx.h"
+
+#define GPDMA_TRANSFERTYPE_P2M 2
+#define GPDMA_CONN_ADC 7
+#define GPDMA_STAT_INTTC 1
+#define GPDMA_STAT_INTERR 2
+#define GPDMA_STATCLR_INTTC 0
+#define GPDMA_STATCLR_INTERR 1
+
+typedef struct {
+	uint32_t ChannelNum;
+	uint32_t TransferSize;
+	uint32_t TransferWidth;
+	uint32_t SrcMemAddr;
+	uint32_t DstMemAddr;
+	uint32_t TransferType;
+	uint32_t SrcConn;
+	uint32_t DstConn;
+	uint32_t DMALLI;
+} GPDMA_Channel_CFG_Type;
+
+void GPDMA_Init(void);
+Status GPDMA_Setup(GPDMA_Channel_CFG_Type* GPDMAChannelConfig);
+void GPDMA_ChannelCmd(uint8_t channelNum, FunctionalState NewState);
+IntStatus GPDMA_IntGetStatus(uint32_t type, uint8_t channel);
+void GPDMA_ClearIntPending(uint32_t type, uint8_t channel);
+
+/* host only: size of the last transfer set up, and a terminal count the
+ * status reports until it is cleared */
+extern uint32_t host_dma_size;
+extern uint8_t host_dma_tc;
+
+#endif /* LPC17XX_GPDMA_H_ */
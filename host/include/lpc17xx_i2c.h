@@ -0,0 +1,9 @@
+#ifndef LPC17XX_I2C_H_
+#define LPC17XX_I2C_H_
+
+#include "LPC17xx.h"
+
+void I2C_Init(LPC_I2C_TypeDef* I2Cx, uint32_t clockrate);
+void I2C_Cmd(LPC_I2C_TypeDef* I2Cx, FunctionalState NewState);
+
+#endif /* LPC17XX_I2C_H_ */
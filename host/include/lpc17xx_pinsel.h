@@ -0,0 +1,16 @@
+#ifndef LPC17XX_PINSEL_H_
+#define LPC17XX_PINSEL_H_
+
+#include "LPC17xx.h"
+
+typedef struct {
+	uint8_t Portnum;
+	uint8_t Pinnum;
+	uint8_t Funcnum;
+	uint8_t Pinmode;
+	uint8_t OpenDrain;
+} PINSEL_CFG_Type;
+
+void PINSEL_ConfigPin(PINSEL_CFG_Type* PinCfg);
+
+#endif /* LPC17XX_PINSEL_H_ */
@@ -0,0 +1,35 @@
+#ifndef LPC17XX_SSP_H_
+#define LPC17XX_SSP_H_
+
+#include "LPC17xx.h"
+
+typedef struct {
+	uint32_t Databit;
+	uint32_t CPHA;
+	uint32_t CPOL;
+	uint32_t Mode;
+	uint32_t FrameFormat;
+	uint32_t ClockRate;
+} SSP_CFG_Type;
+
+typedef struct {
+	void* tx_data;
+	uint32_t tx_cnt;
+	void* rx_data;
+	uint32_t rx_cnt;
+	uint32_t length;
+	uint32_t status;
+} SSP_DATA_SETUP_Type;
+
+typedef enum {
+	SSP_TRANSFER_POLLING = 0,
+	SSP_TRANSFER_INTERRUPT
+} SSP_TRANSFER_Type;
+
+void SSP_ConfigStructInit(SSP_CFG_Type* SSP_InitStruct);
+void SSP_Init(LPC_SSP_TypeDef* SSPx, SSP_CFG_Type* SSP_ConfigStruct);
+void SSP_Cmd(LPC_SSP_TypeDef* SSPx, FunctionalState NewState);
+int32_t SSP_ReadWrite(LPC_SSP_TypeDef* SSPx, SSP_DATA_SETUP_Type* dataCfg,
+		SSP_TRANSFER_Type xfType);
+
+#endif /* LPC17XX_SSP_H_ */
@@ -0,0 +1,9 @@
+#ifndef LPC17XX_TIMER_H_
+#define LPC17XX_TIMER_H_
+
+#include "LPC17xx.h"
+
+void Timer0_Wait(uint32_t time);
+void Timer0_us_Wait(uint32_t time);
+
+#endif /* LPC17XX_TIMER_H_ */
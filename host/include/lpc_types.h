@@ -0,0 +1,18 @@
+/*****************************************************************************
+ *   Host stand-in for the Lib_CMSIS lpc_types.h: the fixed width types and
+ *   the enums the firmware uses, nothing else.
+ *
+ ******************************************************************************/
+#ifndef LPC_TYPES_H
+#define LPC_TYPES_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef enum { RESET = 0, SET = !RESET } FlagStatus, IntStatus, SetState;
+typedef enum { DISABLE = 0, ENABLE = !DISABLE } FunctionalState;
+typedef enum { ERROR = 0, SUCCESS = !ERROR } Status;
+typedef enum { NONE_BLOCKING = 0, BLOCKING } TRANSFER_BLOCK_Type;
+typedef enum { FALSE = 0, TRUE = !FALSE } Bool;
+
+#endif /* LPC_TYPES_H */
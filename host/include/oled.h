@@ -0,0 +1,36 @@
+/*****************************************************************************
+ *   Host stand-in for the EA base board oled.h. oled.c keeps the display
+ *   contents in a frame buffer and counts what the real driver would
+ *   send over SSP.
+ *
+ ******************************************************************************/
+#ifndef __OLED_H
+#define __OLED_H
+
+#include "lpc_types.h"
+
+#define OLED_DISPLAY_WIDTH 96
+#define OLED_DISPLAY_HEIGHT 64
+
+typedef enum {
+	OLED_COLOR_BLACK,
+	OLED_COLOR_WHITE
+} oled_color_t;
+
+void oled_init(void);
+void oled_putPixel(uint8_t x, uint8_t y, oled_color_t color);
+void oled_line(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, oled_color_t color);
+void oled_circle(uint8_t x0, uint8_t y0, uint8_t r, oled_color_t color);
+void oled_rect(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, oled_color_t color);
+void oled_fillRect(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, oled_color_t color);
+void oled_clearScreen(oled_color_t color);
+uint32_t oled_putString(uint8_t x, uint8_t y, uint8_t* pStr, oled_color_t fb, oled_color_t bg);
+uint8_t oled_putChar(uint8_t x, uint8_t y, uint8_t ch, oled_color_t fb, oled_color_t bg);
+
+/* host only: pixel color as the panel shows it, pixels written and
+ * characters oled_putChar() refused for their position */
+oled_color_t oled_pixel(uint8_t x, uint8_t y);
+extern uint32_t oled_pixels_written;
+extern uint32_t oled_chars_clipped;
+
+#endif /* __OLED_H */
@@ -0,0 +1,12 @@
+#ifndef __PCA9532C_H
+#define __PCA9532C_H
+
+#include "lpc_types.h"
+
+void pca9532_init(void);
+void pca9532_setLeds(uint16_t ledOnMask, uint16_t ledOffMask);
+void pca9532_setBlink0Period(uint8_t period);
+void pca9532_setBlink0Duty(uint8_t duty);
+void pca9532_setBlink0Leds(uint16_t ledMask);
+
+#endif /* __PCA9532C_H */
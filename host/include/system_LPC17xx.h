@@ -0,0 +1,10 @@
+#ifndef __SYSTEM_LPC17xx_H
+#define __SYSTEM_LPC17xx_H
+
+#include "lpc_types.h"
+
+extern uint32_t SystemCoreClock;
+
+void SystemInit(void);
+
+#endif /* __SYSTEM_LPC17xx_H */
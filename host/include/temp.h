@@ -0,0 +1,9 @@
+#ifndef __TEMP_H
+#define __TEMP_H
+
+#include "lpc_types.h"
+
+void temp_init(uint32_t (*getMsTicks)(void));
+int32_t temp_read(void);
+
+#endif /* __TEMP_H */
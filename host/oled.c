@@ -0,0 +1,203 @@
+/*****************************************************************************
+ *   Host model of the EA base board OLED driver. Drawing follows the
+ *   structure of EA oled.c (lines and rectangles are pixel loops, a pixel
+ *   rewrites its whole page byte) so the traffic it generates matches the
+ *   board; see send().
+ *
+ ******************************************************************************/
+#include <string.h>
+
+#include "lpc17xx_gpio.h"
+#include "lpc17xx_ssp.h"
+#include "oled.h"
+#include "font5x7.h"
+
+#define PAGES (OLED_DISPLAY_HEIGHT / 8)
+
+/* chip select P0.6, active low, as in EA oled.c */
+#define OLED_CS_ON() GPIO_ClearValue(0, 1 << 6)
+#define OLED_CS_OFF() GPIO_SetValue(0, 1 << 6)
+
+static uint8_t shadow[PAGES][OLED_DISPLAY_WIDTH];
+
+uint32_t oled_pixels_written;
+uint32_t oled_chars_clipped;
+
+/* EA oled.c: every pixel is setAddress() (3 command bytes) and one data
+ * byte, a cleared page is setAddress() and a row of data bytes; each goes
+ * out over SSP1 with the display selected */
+static void send(uint32_t commands, uint32_t data)
+{
+	static uint8_t zeros[OLED_DISPLAY_WIDTH];
+	SSP_DATA_SETUP_Type xfer;
+
+	OLED_CS_ON();
+	memset(&xfer, 0, sizeof(xfer));
+	xfer.tx_data = zeros;
+	xfer.length = commands + data;
+	SSP_ReadWrite(LPC_SSP1, &xfer, SSP_TRANSFER_POLLING);
+	OLED_CS_OFF();
+}
+
+void oled_init(void)
+{
+	memset(shadow, 0, sizeof(shadow));
+	oled_pixels_written = 0;
+	oled_chars_clipped = 0;
+	OLED_CS_OFF();
+}
+
+void oled_putPixel(uint8_t x, uint8_t y, oled_color_t color)
+{
+	if (x >= OLED_DISPLAY_WIDTH || y >= OLED_DISPLAY_HEIGHT)
+		return;
+	if (color != OLED_COLOR_BLACK)
+		shadow[y / 8][x] |= 1 << (y & 7);
+	else
+		shadow[y / 8][x] &= ~(1 << (y & 7));
+	oled_pixels_written++;
+	send(3, 1);
+}
+
+oled_color_t oled_pixel(uint8_t x, uint8_t y)
+{
+	return (shadow[y / 8][x] & (1 << (y & 7))) ? OLED_COLOR_WHITE : OLED_COLOR_BLACK;
+}
+
+static void hline(uint8_t x0, uint8_t y0, uint8_t x1, oled_color_t color)
+{
+	uint8_t t;
+
+	if (x0 > x1) {
+		t = x0;
+		x0 = x1;
+		x1 = t;
+	}
+	for (int x = x0; x <= x1; x++)
+		oled_putPixel(x, y0, color);
+}
+
+static void vline(uint8_t x0, uint8_t y0, uint8_t y1, oled_color_t color)
+{
+	uint8_t t;
+
+	if (y0 > y1) {
+		t = y0;
+		y0 = y1;
+		y1 = t;
+	}
+	for (int y = y0; y <= y1; y++)
+		oled_putPixel(x0, y, color);
+}
+
+void oled_line(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, oled_color_t color)
+{
+	int dx, dy, sx, sy, err, e2;
+
+	if (y0 == y1) {
+		hline(x0, y0, x1, color);
+		return;
+	}
+	if (x0 == x1) {
+		vline(x0, y0, y1, color);
+		return;
+	}
+	dx = x1 > x0 ? x1 - x0 : x0 - x1;
+	dy = y1 > y0 ? y1 - y0 : y0 - y1;
+	sx = x0 < x1 ? 1 : -1;
+	sy = y0 < y1 ? 1 : -1;
+	err = dx - dy;
+	while (1) {
+		oled_putPixel(x0, y0, color);
+		if (x0 == x1 && y0 == y1)
+			break;
+		e2 = 2 * err;
+		if (e2 > -dy) {
+			err -= dy;
+			x0 += sx;
+		}
+		if (e2 < dx) {
+			err += dx;
+			y0 += sy;
+		}
+	}
+}
+
+void oled_circle(uint8_t x0, uint8_t y0, uint8_t r, oled_color_t color)
+{
+	int f = 1 - r;
+	int ddx = 1;
+	int ddy = -2 * r;
+	int x = 0;
+	int y = r;
+
+	oled_putPixel(x0, y0 + r, color);
+	oled_putPixel(x0, y0 - r, color);
+	oled_putPixel(x0 + r, y0, color);
+	oled_putPixel(x0 - r, y0, color);
+	while (x < y) {
+		if (f >= 0) {
+			y--;
+			ddy += 2;
+			f += ddy;
+		}
+		x++;
+		ddx += 2;
+		f += ddx;
+		oled_putPixel(x0 + x, y0 + y, color);
+		oled_putPixel(x0 - x, y0 + y, color);
+		oled_putPixel(x0 + x, y0 - y, color);
+		oled_putPixel(x0 - x, y0 - y, color);
+		oled_putPixel(x0 + y, y0 + x, color);
+		oled_putPixel(x0 - y, y0 + x, color);
+		oled_putPixel(x0 + y, y0 - x, color);
+		oled_putPixel(x0 - y, y0 - x, color);
+	}
+}
+
+void oled_rect(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, oled_color_t color)
+{
+	hline(x0, y0, x1, color);
+	hline(x0, y1, x1, color);
+	vline(x0, y0, y1, color);
+	vline(x1, y0, y1, color);
+}
+
+void oled_fillRect(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, oled_color_t color)
+{
+	for (int y = y0; y <= y1; y++)
+		hline(x0, y, x1, color);
+}
+
+void oled_clearScreen(oled_color_t color)
+{
+	memset(shadow, color != OLED_COLOR_BLACK ? 0xFF : 0x00, sizeof(shadow));
+	for (int p = 0; p < PAGES; p++)
+		send(3, OLED_DISPLAY_WIDTH);
+}
+
+uint8_t oled_putChar(uint8_t x, uint8_t y, uint8_t ch, oled_color_t fb, oled_color_t bg)
+{
+	if (x >= OLED_DISPLAY_WIDTH - 8 || y >= OLED_DISPLAY_HEIGHT - 8) {
+		oled_chars_clipped++;
+		return 0;
+	}
+	if (ch < 0x20 || ch > 0x7f)
+		ch = 0x20;
+	ch -= 0x20;
+	for (int r = 0; r < 8; r++)
+		for (int j = 0; j < 6; j++)
+			oled_putPixel(x + j, y + r, (font5x7[ch][r] & (0x80 >> j)) ? fb : bg);
+	return 1;
+}
+
+uint32_t oled_putString(uint8_t x, uint8_t y, uint8_t* pStr, oled_color_t fb, oled_color_t bg)
+{
+	uint32_t n = 0;
+
+	while (*pStr != '\0' && oled_putChar(x, y, *pStr++, fb, bg)) {
+		x += 6;
+		n++;
+	}
+	return n;
+}
@@ -0,0 +1,305 @@
+/*****************************************************************************
+ *   Replays a .lpct trace recorded on the board through the firmware's own
+ *   main loop (src/main.c built for the host) and writes the trace the
+ *   host run produces, for tools/trace_check.py.
+ *
+ *     replay board.lpct replayed.lpct
+ *
+ *   The recorded input events are delivered at their ticks and the
+ *   recorded sensor samples are what the sensor reads return, so the
+ *   render and record paths do the same work as on the board. Time is
+ *   simulated: __WFI() and the beep's timer waits advance the SysTick
+ *   count. EEPROM bytes come from history.c on the host EEPROM model,
+ *   display bytes from the real SSP_ReadWrite() wrapper in oled_graphing.c
+ *   behind the host OLED model, and loop times are host nanoseconds (see
+ *   include/dwt.h). The drivers with nothing to replay are in board.c.
+ *
+ ******************************************************************************/
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define main fw_main
+#include "../src/main.c"
+#undef main
+
+#define LPCT_HEADER 16
+#define LPCT_VERSION 1
+#define LPCT_TICK_HZ 1000
+
+typedef struct {
+	uint32_t tick;
+	uint8_t type;
+	uint8_t id;
+	uint16_t code;
+	int32_t value;
+} record_t;
+
+/* recorded trace */
+static record_t* in;
+static uint32_t in_count;
+static uint32_t in_next;
+static uint32_t end_tick;
+
+/* sensor values as last recorded, by data_type */
+static int32_t recorded[NUM_SENSORS];
+
+/* input events due, drained by input_get() */
+static input_event_t events[INPUT_QUEUE_LEN];
+static uint32_t ev_head;
+static uint32_t ev_tail;
+static uint32_t ev_dropped;
+
+/* replayed trace */
+static FILE* out;
+static uint32_t out_count;
+static uint8_t frame[TRACE_FRAME_BYTES];
+static uint32_t frame_len;
+
+static uint32_t us_left;
+static jmp_buf done;
+
+/* board and replay totals */
+static uint64_t board_eeprom, board_display;
+static uint64_t sim_eeprom, sim_display;
+
+static uint32_t get_le(const uint8_t* p, int n)
+{
+	uint32_t v = 0;
+
+	while (n-- > 0)
+		v = (v << 8) | p[n];
+	return v;
+}
+
+static void put_le(uint8_t* p, uint32_t v, int n)
+{
+	for (int i = 0; i < n; i++)
+		p[i] = (uint8_t)(v >> (8 * i));
+}
+
+static int load(const char* path)
+{
+	FILE* f = fopen(path, "rb");
+	uint8_t h[LPCT_HEADER], r[TRACE_REC_BYTES];
+	uint32_t count;
+
+	if (f == NULL || fread(h, 1, sizeof(h), f) != sizeof(h) ||
+			h[0] != 'L' || h[1] != 'P' || h[2] != 'C' || h[3] != 'T' ||
+			get_le(h + 4, 2) != LPCT_VERSION || get_le(h + 6, 2) != TRACE_REC_BYTES) {
+		fprintf(stderr, "%s: not a version %d trace\n", path, LPCT_VERSION);
+		return 1;
+	}
+	// a recorder that was killed leaves the count at zero
+	count = get_le(h + 12, 4);
+	in = malloc(sizeof(record_t) * (count ? count : 1));
+	for (in_count = 0; fread(r, 1, sizeof(r), f) == sizeof(r); in_count++) {
+		if (count != 0 && in_count == count)
+			break;
+		if (count == 0)
+			in = realloc(in, sizeof(record_t) * (in_count + 1));
+		in[in_count].tick = get_le(r, 4);
+		in[in_count].type = r[4];
+		in[in_count].id = r[5];
+		in[in_count].code = (uint16_t)get_le(r + 6, 2);
+		in[in_count].value = (int32_t)get_le(r + 8, 4);
+	}
+	fclose(f);
+	if (in_count == 0) {
+		fprintf(stderr, "%s: no records\n", path);
+		return 1;
+	}
+	return 0;
+}
+
+static void write_header(uint32_t count)
+{
+	uint8_t h[LPCT_HEADER] = { 'L', 'P', 'C', 'T' };
+
+	put_le(h + 4, LPCT_VERSION, 2);
+	put_le(h + 6, TRACE_REC_BYTES, 2);
+	put_le(h + 8, LPCT_TICK_HZ, 4);
+	put_le(h + 12, count, 4);
+	fseek(out, 0, SEEK_SET);
+	fwrite(h, 1, sizeof(h), out);
+}
+
+/* sensor reads return the recorded values in raw units */
+static void set_recorded(uint8_t id, int32_t value)
+{
+	if (id >= NUM_SENSORS)
+		return;
+	recorded[id] = value;
+	if (id == 2)
+		host_adc.ADDR[ADC_CHANNEL_0] = (uint32_t)(value & 0xFFF) << 4;
+}
+
+static int32_t raw(int id)
+{
+	return sensors[id].scale > 1 ? recorded[id] * sensors[id].scale : recorded[id];
+}
+
+/* hand over every record due by now; past the end the run is over */
+static void deliver(uint32_t now)
+{
+	while (in_next < in_count && in[in_next].tick <= now) {
+		const record_t* r = &in[in_next++];
+
+		switch (r->type) {
+		case TRACE_INPUT:
+			if (ev_head - ev_tail >= INPUT_QUEUE_LEN) {
+				ev_dropped++;
+				break;
+			}
+			events[ev_head % INPUT_QUEUE_LEN].src = r->id;
+			events[ev_head % INPUT_QUEUE_LEN].code = (uint8_t)r->code;
+			events[ev_head % INPUT_QUEUE_LEN].tick = r->tick;
+			ev_head++;
+			break;
+		case TRACE_SAMPLE:
+			set_recorded(r->id, r->value);
+			break;
+		case TRACE_EEPROM:
+			board_eeprom += (uint32_t)r->value;
+			break;
+		case TRACE_DISPLAY:
+			board_display += (uint32_t)r->value;
+			break;
+		}
+	}
+	if (now > end_tick)
+		longjmp(done, 1);
+}
+
+static void tick(void)
+{
+	SysTick_Handler();
+	deliver(getTicks());
+}
+
+/* ---- the board as the firmware sees it ---- */
+
+void __WFI(void)
+{
+	tick();
+}
+
+void Timer0_Wait(uint32_t ms)
+{
+	while (ms-- > 0)
+		tick();
+}
+
+void Timer0_us_Wait(uint32_t us)
+{
+	for (us_left += us; us_left >= 1000; us_left -= 1000)
+		tick();
+}
+
+void input_init(uint32_t (*getMsTicks)(void))
+{
+	(void)getMsTicks;
+	// the board starts tracing from the diagnostics mode, the replay as
+	// soon as the main loop runs
+	trace_enable(1, getTicks());
+}
+
+int input_get(input_event_t* ev)
+{
+	if (ev_tail == ev_head)
+		return 0;
+	*ev = events[ev_tail++ % INPUT_QUEUE_LEN];
+	return 1;
+}
+
+uint32_t input_dropped(void)
+{
+	return ev_dropped;
+}
+
+int32_t temp_read(void) { return raw(0); }
+uint32_t light_read(void) { return (uint32_t)raw(1); }
+
+int vib_get(vib_metrics_t* m)
+{
+	m->rms_mg = (uint16_t)raw(3);
+	return 1;
+}
+
+/* the trace frames the firmware sends, unframed into the output file */
+uint32_t serial_write_nb(const uint8_t* data, uint32_t len)
+{
+	uint8_t sum = 0;
+
+	for (uint32_t i = 0; i < len; i++) {
+		if (frame_len == 0 && data[i] != TRACE_SYNC)
+			continue;
+		frame[frame_len++] = data[i];
+		if (frame_len < TRACE_FRAME_BYTES)
+			continue;
+		frame_len = 0;
+		sum = 0;
+		for (int k = 1; k <= TRACE_REC_BYTES; k++)
+			sum += frame[k];
+		if (sum != frame[TRACE_FRAME_BYTES - 1])
+			continue;
+		if (frame[5] == TRACE_EEPROM)
+			sim_eeprom += get_le(frame + 9, 4);
+		else if (frame[5] == TRACE_DISPLAY)
+			sim_display += get_le(frame + 9, 4);
+		fwrite(frame + 1, 1, TRACE_REC_BYTES, out);
+		out_count++;
+	}
+	return len;
+}
+
+int main(int argc, char** argv)
+{
+	uint32_t i;
+	int result = 0;
+
+	if (argc != 3) {
+		fprintf(stderr, "usage: %s board.lpct replayed.lpct\n", argv[0]);
+		return 2;
+	}
+	if (load(argv[1]) != 0)
+		return 1;
+	out = fopen(argv[2], "wb");
+	if (out == NULL) {
+		perror(argv[2]);
+		return 1;
+	}
+	write_header(0);
+
+	// start where the board was: its clock, mode and sensor
+	for (i = 0; i < in_count; i++) {
+		if (in[i].type == TRACE_MODE) {
+			mode = in[i].id;
+			data_type = in[i].code < NUM_SENSORS ? in[i].code : 0;
+			break;
+		}
+	}
+	msTicks = in[0].tick;
+	// one more period so the counters of the last one are reported
+	end_tick = in[in_count - 1].tick + TRACE_PERIOD_MS;
+	draw_graph = draw_record = draw_recorded = 1;
+
+	if (setjmp(done) == 0)
+		result = fw_main();
+	else
+		trace_flush();
+
+	write_header(out_count);
+	fclose(out);
+
+	printf("%u records in, %u out, %.1f s\n", in_count, out_count,
+			(end_tick - in[0].tick) / 1000.0);
+	printf("%-8s %12s %12s\n", "", "eeprom B", "display B");
+	printf("%-8s %12llu %12llu\n", "board", (unsigned long long)board_eeprom,
+			(unsigned long long)board_display);
+	printf("%-8s %12llu %12llu\n", "replay", (unsigned long long)sim_eeprom,
+			(unsigned long long)sim_display);
+	if (result != 0)
+		fprintf(stderr, "firmware stopped with %d\n", result);
+	return result;
+}
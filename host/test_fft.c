@@ -0,0 +1,135 @@
+/*****************************************************************************
+ *   fft_q15() against a double precision DFT for every size, plus the
+ *   window, magnitude and log helpers
+ *
+ ******************************************************************************/
+#include <math.h>
+#include <stdlib.h>
+
+#include "fft.h"
+#include "check.h"
+
+static int16_t re[FFT_MAX_N];
+static int16_t im[FFT_MAX_N];
+static double ref_re[FFT_MAX_N];
+static double ref_im[FFT_MAX_N];
+
+/* DFT scaled by 1/n, the scaling fft_q15() applies */
+static void dft(const int16_t* x, int n)
+{
+	for (int k = 0; k < n; k++) {
+		double sr = 0, si = 0;
+
+		for (int i = 0; i < n; i++) {
+			sr += x[i] * cos(2 * M_PI * k * i / n);
+			si -= x[i] * sin(2 * M_PI * k * i / n);
+		}
+		ref_re[k] = sr / n;
+		ref_im[k] = si / n;
+	}
+}
+
+/* largest error over all bins, in Q15 LSBs */
+static double compare(int log2n)
+{
+	int n = 1 << log2n;
+	double worst = 0;
+
+	dft(re, n);
+	fft_q15(re, im, log2n);
+	for (int k = 0; k < n; k++) {
+		double e = hypot(re[k] - ref_re[k], im[k] - ref_im[k]);
+		if (e > worst)
+			worst = e;
+	}
+	return worst;
+}
+
+static void test_accuracy(void)
+{
+	srand(2);
+	for (int log2n = FFT_LOG2_MIN; log2n <= FFT_LOG2_MAX; log2n++) {
+		int n = 1 << log2n;
+		double err;
+
+		// two tones and noise at the input scale spectrum_update() uses
+		for (int i = 0; i < n; i++) {
+			double v = 12000 * sin(2 * M_PI * 5 * i / n)
+					+ 6000 * cos(2 * M_PI * (n / 4 + 3) * i / n)
+					+ (rand() % 2001 - 1000);
+			re[i] = (int16_t)v;
+			im[i] = 0;
+		}
+		err = compare(log2n);
+		printf("  n = %3d: max error %.2f LSB\n", n, err);
+		// each stage rounds by up to about one LSB
+		CHECK(err <= log2n);
+
+		// full scale square wave must not wrap
+		for (int i = 0; i < n; i++) {
+			re[i] = (i & 8) ? 32767 : -32768;
+			im[i] = 0;
+		}
+		CHECK(compare(log2n) <= log2n);
+	}
+}
+
+static void test_bins(void)
+{
+	uint16_t mag[FFT_MAX_N / 2];
+	int n = 256;
+	int peak = 0;
+
+	// a pure tone shows up in its bin at half its amplitude
+	for (int i = 0; i < n; i++) {
+		re[i] = (int16_t)(16000 * cos(2 * M_PI * 20 * i / n));
+		im[i] = 0;
+	}
+	fft_q15(re, im, 8);
+	fft_magnitude(re, im, mag, n / 2);
+	for (int k = 1; k < n / 2; k++)
+		if (mag[k] > mag[peak])
+			peak = k;
+	CHECK_EQ(peak, 20);
+	CHECK(abs(mag[20] - 8000) <= 8);
+	CHECK(mag[19] <= 8 && mag[21] <= 8);
+}
+
+static void test_window(void)
+{
+	int n = 64;
+
+	for (int i = 0; i < n; i++)
+		re[i] = 20000;
+	fft_window(re, 6);
+	// Hann: zero at the ends, full at the centre, symmetric
+	CHECK_EQ(re[0], 0);
+	CHECK(abs(re[n / 2] - 20000) <= 1);
+	for (int i = 1; i < n / 2; i++)
+		CHECK(abs(re[i] - re[n - i]) <= 1);
+}
+
+static void test_log2(void)
+{
+	CHECK_EQ(fft_log2_q2(0), 0);
+	CHECK_EQ(fft_log2_q2(1), 0);
+	CHECK_EQ(fft_log2_q2(2), 4);
+	CHECK_EQ(fft_log2_q2(3), 6);
+	CHECK_EQ(fft_log2_q2(1024), 40);
+	CHECK_EQ(fft_log2_q2(65535), 63);
+	// the fraction is read linearly off the mantissa: within a quarter
+	// step plus the 0.086 of log2(1 + f) ~ f, never decreasing
+	for (uint32_t v = 2; v < 100000; v++) {
+		CHECK(fabs(fft_log2_q2(v) / 4.0 - log2(v)) < 0.25 + 0.087);
+		CHECK(fft_log2_q2(v) >= fft_log2_q2(v - 1));
+	}
+}
+
+int main(void)
+{
+	test_accuracy();
+	test_bins();
+	test_window();
+	test_log2();
+	return check_done("test_fft");
+}
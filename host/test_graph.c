@@ -0,0 +1,38 @@
+/*****************************************************************************
+ *   draw_data() scaling: where a sample lands in the 40 pixel graph
+ *
+ ******************************************************************************/
+#include "oled_graphing.h"
+#include "check.h"
+
+/* row of the point drawn for one sample, -1 if none */
+static int point_y(uint16_t min, uint16_t max, uint16_t value)
+{
+	uint16_t data[1] = { value };
+
+	oled_init();
+	draw_graph_outline(4, OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+	draw_data(min, max, data, 1);
+	// the circle's centre column is the axis, so look one to the right
+	for (int y = 15; y <= 56; y++)
+		if (oled_pixel(11, y) == OLED_COLOR_BLACK)
+			return y;
+	return -1;
+}
+
+int main(void)
+{
+	// 17 is the top of the graph, 57 the axis (no point drawn there)
+	CHECK_EQ(point_y(25, 35, 35), 17);
+	CHECK_EQ(point_y(25, 35, 40), 17);
+	CHECK_EQ(point_y(25, 35, 30), 37);
+	CHECK_EQ(point_y(25, 35, 26), 53);
+	CHECK_EQ(point_y(25, 35, 25), -1);
+	CHECK_EQ(point_y(25, 35, 3), -1);
+	// truncated toward the axis like the float scaling it replaces
+	CHECK_EQ(point_y(99, 4100, 2000), 17 + 40 - (2000 - 99) * 40 / 4001);
+	CHECK_EQ(point_y(0, 500, 499), 18);
+	// an empty range does not divide by zero
+	CHECK_EQ(point_y(10, 10, 11), 17);
+	return check_done("test_graph");
+}
@@ -0,0 +1,232 @@
+/*****************************************************************************
+ *   hist_open() and hist_append() on the host EEPROM model: layout word,
+ *   finding the newest record from the sequence numbers at every fill
+ *   level, across laps and the sequence wrap, what an append writes, and
+ *   hist_fetch() views panned and zoomed across the end of the ring.
+ *
+ ******************************************************************************/
+#include <string.h>
+
+#include "eeprom.h"
+#include "history.h"
+#include "check.h"
+
+static hist_log_t log_a;
+static hist_log_t log_b;
+static uint16_t samples[HIST_REC_SAMPLES];
+static uint16_t got[HIST_REC_SAMPLES];
+
+static uint32_t get32(uint16_t addr)
+{
+	const uint8_t* b = eeprom_mem + addr;
+
+	return ((uint32_t)b[0] << 24) | ((uint32_t)b[1] << 16) | ((uint32_t)b[2] << 8) | b[3];
+}
+
+static void fill(uint32_t n)
+{
+	for (int i = 0; i < HIST_REC_SAMPLES; i++)
+		samples[i] = (uint16_t)(n * 100 + i);
+}
+
+static void test_layout(void)
+{
+	// erased EEPROM: empty log, layout word written, nothing else
+	eeprom_init();
+	CHECK_EQ(hist_open(&log_a, HIST_REGION(1), 0), 0);
+	CHECK_EQ(log_a.total, 0);
+	CHECK_EQ(get32(4), HIST_MAGIC);
+	CHECK_EQ(get32(0), 0xFFFFFFFF);
+	CHECK(hist_latest(&log_a, got) != 0);
+
+	// older layout: a temperature where the directory is and plausible
+	// records in the region are not taken for a log
+	eeprom_init();
+	memset(eeprom_mem, 0, sizeof(eeprom_mem));
+	eeprom_mem[1] = 235;
+	CHECK_EQ(hist_open(&log_a, HIST_REGION(0), 0), 0);
+	CHECK_EQ(log_a.total, 0);
+	CHECK_EQ(get32(0), HIST_MAGIC);
+	CHECK_EQ(hist_open(&log_a, HIST_REGION(0), 0), 0);
+	CHECK_EQ(log_a.total, 0);
+
+	// another version of the layout is cleared as well
+	eeprom_mem[3] ^= 1;
+	fill(0);
+	CHECK_EQ(hist_append(&log_a, samples, 1, 0), 0);
+	CHECK_EQ(hist_open(&log_a, HIST_REGION(0), 0), 0);
+	CHECK_EQ(log_a.total, 0);
+}
+
+static void test_newest(void)
+{
+	static const uint32_t counts[] = {
+		1, 2, 38, 39, 40, HIST_RECORDS - 1, HIST_RECORDS, HIST_RECORDS + 1,
+		2 * HIST_RECORDS - 1, 2 * HIST_RECORDS, 5 * HIST_RECORDS + 17,
+	};
+
+	for (unsigned c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+		uint32_t n = counts[c];
+
+		eeprom_init();
+		CHECK_EQ(hist_open(&log_a, HIST_REGION(2), 0), 0);
+		for (uint32_t i = 0; i < n; i++) {
+			fill(i);
+			CHECK_EQ(hist_append(&log_a, samples, 1, 10 * i), 0);
+		}
+
+		CHECK_EQ(hist_open(&log_b, HIST_REGION(2), 5), 0);
+		CHECK_EQ(log_b.total, n);
+		CHECK_EQ(hist_latest(&log_b, got), 0);
+		CHECK_EQ(got[0], (uint16_t)((n - 1) * 100));
+		CHECK_EQ(got[HIST_REC_SAMPLES - 1], (uint16_t)((n - 1) * 100 + HIST_REC_SAMPLES - 1));
+		// log time continues after the newest record
+		CHECK_EQ(log_b.epoch + 5, 10 * (n - 1) + 1);
+
+		// the next append goes on from there
+		fill(n);
+		CHECK_EQ(hist_append(&log_b, samples, 1, 6), 0);
+		CHECK_EQ(hist_open(&log_a, HIST_REGION(2), 0), 0);
+		CHECK_EQ(log_a.total, n + 1);
+		CHECK_EQ(hist_build(&log_a, NULL), 0);
+		CHECK_EQ(hist_time_at(&log_a, hist_samples(&log_a) - 1), 10 * (n - 1) + 2);
+	}
+}
+
+static void test_append_writes(void)
+{
+	uint32_t before;
+
+	eeprom_init();
+	CHECK_EQ(hist_open(&log_a, HIST_REGION(3), 0), 0);
+	fill(1);
+	before = hist_bytes_written;
+	CHECK_EQ(hist_append(&log_a, samples, 1, 0), 0);
+	// the record and nothing else, the directory is left alone
+	CHECK_EQ(hist_bytes_written - before, HIST_REC_BYTES);
+	CHECK_EQ(get32(12), HIST_MAGIC);
+}
+
+/* sample p of the log, 0 the oldest, when record i holds fill(i) */
+static uint16_t expect(uint32_t appended, uint32_t p)
+{
+	uint32_t oldest = appended > HIST_RECORDS ? appended - HIST_RECORDS : 0;
+
+	return (uint16_t)((oldest + p / HIST_REC_SAMPLES) * 100 + p % HIST_REC_SAMPLES);
+}
+
+/* every view the replay can ask for, against the samples appended */
+static void check_views(hist_log_t* log, uint32_t appended)
+{
+	static uint16_t out[HIST_RECORDS * HIST_REC_SAMPLES];
+	uint32_t total = hist_samples(log);
+
+	for (int zoom = 0; zoom <= 6; zoom++) {
+		uint16_t span = HIST_REC_SAMPLES << zoom;
+		uint16_t points = span < 80 ? span : 80;
+		uint16_t group = span / points;
+
+		if (span > total)
+			break;
+		for (uint32_t from = 0; from + span <= total; from += 7) {
+			uint32_t bytes = 0;
+			int ok = 1;
+
+			CHECK_EQ(hist_fetch(log, from, span, group, out, &bytes), 0);
+			for (uint16_t k = 0; ok && k < points; k++) {
+				uint32_t sum = 0;
+
+				for (uint16_t g = 0; g < group; g++)
+					sum += expect(appended, from + k * group + g);
+				ok = out[k] == sum / group;
+			}
+			CHECK(ok);
+			// the samples and at most the headers between them
+			CHECK(bytes >= 2u * span);
+			CHECK(bytes <= 2u * span + HIST_HDR_BYTES * (span / HIST_REC_SAMPLES + 1));
+		}
+	}
+	// past the end
+	CHECK_EQ(hist_fetch(log, total - HIST_REC_SAMPLES + 1, HIST_REC_SAMPLES, 1, out, NULL), 1);
+}
+
+static void test_fetch(void)
+{
+	static const uint32_t counts[] = { 3, HIST_RECORDS, HIST_RECORDS + 5, 2 * HIST_RECORDS + 41 };
+
+	for (unsigned c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+		eeprom_init();
+		CHECK_EQ(hist_open(&log_a, HIST_REGION(1), 0), 0);
+		for (uint32_t i = 0; i < counts[c]; i++) {
+			fill(i);
+			CHECK_EQ(hist_append(&log_a, samples, 1, i), 0);
+		}
+		check_views(&log_a, counts[c]);
+		// and the same after a power cycle
+		CHECK_EQ(hist_open(&log_b, HIST_REGION(1), 0), 0);
+		CHECK_EQ(hist_build(&log_b, NULL), 0);
+		check_views(&log_b, counts[c]);
+	}
+}
+
+static void test_seq_wrap(void)
+{
+	static const uint32_t after[] = { 0, 1, 39, HIST_RECORDS - 1, HIST_RECORDS + 3 };
+
+	for (unsigned c = 0; c < sizeof(after) / sizeof(after[0]); c++) {
+		uint32_t n = 2 * HIST_RECORDS + after[c];
+
+		// a log two laps short of the wrap, as if it had run that long
+		eeprom_init();
+		CHECK_EQ(hist_open(&log_a, HIST_REGION(3), 0), 0);
+		log_a.total = HIST_SEQ_WRAP - 2 * HIST_RECORDS;
+		for (uint32_t i = 0; i < n; i++) {
+			fill(i);
+			CHECK_EQ(hist_append(&log_a, samples, 1, i), 0);
+		}
+		CHECK_EQ(log_a.total, after[c]);
+		CHECK(log_a.lapped);
+
+		CHECK_EQ(hist_open(&log_b, HIST_REGION(3), 0), 0);
+		CHECK_EQ(log_b.total, after[c]);
+		CHECK_EQ(hist_samples(&log_b), HIST_RECORDS * HIST_REC_SAMPLES);
+		CHECK_EQ(hist_latest(&log_b, got), 0);
+		CHECK_EQ(got[0], (uint16_t)((n - 1) * 100));
+		CHECK_EQ(hist_build(&log_b, NULL), 0);
+		check_views(&log_b, n);
+
+		// appends go on from the wrapped number
+		fill(n);
+		CHECK_EQ(hist_append(&log_b, samples, 1, 0), 0);
+		CHECK_EQ(hist_open(&log_a, HIST_REGION(3), 0), 0);
+		CHECK_EQ(log_a.total, after[c] + 1);
+		CHECK_EQ(hist_latest(&log_a, got), 0);
+		CHECK_EQ(got[0], (uint16_t)(n * 100));
+	}
+}
+
+static void test_errors(void)
+{
+	eeprom_init();
+	eeprom_reads_left = 0;
+	CHECK_EQ(hist_open(&log_a, HIST_REGION(0), 0), 1);
+
+	// failing in the middle of the search
+	eeprom_init();
+	CHECK_EQ(hist_open(&log_a, HIST_REGION(0), 0), 0);
+	for (uint32_t i = 0; i < 50; i++)
+		CHECK_EQ(hist_append(&log_a, samples, 1, i), 0);
+	eeprom_reads_left = 4;
+	CHECK_EQ(hist_open(&log_a, HIST_REGION(0), 0), 1);
+}
+
+int main(void)
+{
+	test_layout();
+	test_newest();
+	test_append_writes();
+	test_fetch();
+	test_seq_wrap();
+	test_errors();
+	return check_done("test_history");
+}
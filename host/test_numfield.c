@@ -0,0 +1,114 @@
+/*****************************************************************************
+ *   numfield_show() on the host OLED model: what the cells show, and that
+ *   only the pixels that differ are written
+ *
+ ******************************************************************************/
+#include <string.h>
+
+#include "oled_graphing.h"
+#include "font5x7.h"
+#include "check.h"
+
+#define X 10
+#define Y 20
+
+static numfield_t f;
+
+/* cell i shows ch in black on white */
+static int cell_is(int i, uint8_t ch)
+{
+	for (int r = 0; r < 8; r++) {
+		for (int j = 0; j < 6; j++) {
+			oled_color_t want = (font5x7[ch - 0x20][r] & (0x80 >> j)) ?
+					OLED_COLOR_BLACK : OLED_COLOR_WHITE;
+
+			if (oled_pixel(X + 6 * i + j, Y + r) != want)
+				return 0;
+		}
+	}
+	return 1;
+}
+
+static int field_is(const char* text)
+{
+	for (int i = 0; i < f.cells; i++)
+		if (!cell_is(i, (uint8_t)text[i]))
+			return 0;
+	return 1;
+}
+
+static uint32_t show(const char* text)
+{
+	uint32_t before = oled_pixels_written;
+
+	numfield_show(&f, (const uint8_t*)text, (uint8_t)strlen(text));
+	return oled_pixels_written - before;
+}
+
+static int bits(uint8_t a, uint8_t b)
+{
+	int n = 0;
+
+	for (int r = 0; r < 8; r++)
+		n += __builtin_popcount(font5x7[a - 0x20][r] ^ font5x7[b - 0x20][r]);
+	return n;
+}
+
+static void test_show(void)
+{
+	oled_init();
+	oled_clearScreen(OLED_COLOR_WHITE);
+	numfield_init(&f, X, Y, 4, OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+	CHECK(field_is("    "));
+
+	// right aligned, padded with spaces
+	show("25.7");
+	CHECK(field_is("25.7"));
+	show("-3");
+	CHECK(field_is("  -3"));
+
+	// one changed cell costs the pixels where the glyphs differ
+	show("25.7");
+	CHECK_EQ(show("25.8"), bits('7', '8'));
+	CHECK(field_is("25.8"));
+	CHECK_EQ(show("25.8"), 0);
+	CHECK_EQ(show("0"), bits('2', ' ') + bits('5', ' ') + bits('.', ' ') + bits('8', '0'));
+	CHECK(field_is("   0"));
+
+	// too long: the whole field says so instead of dropping digits
+	show("12345");
+	CHECK(field_is("####"));
+	CHECK_EQ(show("99999"), 0);
+	show("1234");
+	CHECK(field_is("1234"));
+	show("");
+	CHECK(field_is("    "));
+
+	// nothing outside the field is touched
+	show("-8.8");
+	for (int r = 0; r < 8; r++) {
+		CHECK(oled_pixel(X - 1, Y + r) == OLED_COLOR_WHITE);
+		CHECK(oled_pixel(X + 24, Y + r) == OLED_COLOR_WHITE);
+	}
+}
+
+static void test_bytes(void)
+{
+	uint32_t before;
+
+	// every pixel is setAddress() and one data byte
+	oled_init();
+	oled_clearScreen(OLED_COLOR_WHITE);
+	numfield_init(&f, X, Y, 4, OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+	show("23.4");
+	before = oled_bytes;
+	show("23.5");
+	CHECK_EQ(oled_bytes - before, 4 * bits('4', '5'));
+}
+
+int main(void)
+{
+	test_show();
+	test_bytes();
+	return check_done("test_numfield");
+}
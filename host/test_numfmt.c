@@ -0,0 +1,83 @@
+/*****************************************************************************
+ *   fmt_u32(), fmt_i32() and fmt_tenths(): the text and length written at
+ *   the digit count changes and the ends of the range, and that none of
+ *   them writes past FMT_BUF bytes
+ *
+ ******************************************************************************/
+#include <stdint.h>
+#include <string.h>
+
+#include "numfmt.h"
+#include "check.h"
+
+#define GUARD 0xAA
+
+static uint8_t buf[FMT_BUF + 1];
+
+static void fill(void)
+{
+	memset(buf, GUARD, sizeof(buf));
+}
+
+/* the last call wrote want and returned its length */
+static int wrote(uint8_t len, const char* want)
+{
+	return len == strlen(want) && strcmp((char*)buf, want) == 0 &&
+			buf[FMT_BUF] == GUARD;
+}
+
+#define EXPECT(call, want) do { \
+		fill(); \
+		CHECK(wrote(call, want)); \
+	} while (0)
+
+static void test_u32(void)
+{
+	EXPECT(fmt_u32(0, buf), "0");
+	EXPECT(fmt_u32(9, buf), "9");
+	EXPECT(fmt_u32(10, buf), "10");
+	EXPECT(fmt_u32(99, buf), "99");
+	EXPECT(fmt_u32(100, buf), "100");
+	EXPECT(fmt_u32(1000000007, buf), "1000000007");
+	EXPECT(fmt_u32(INT32_MAX, buf), "2147483647");
+	EXPECT(fmt_u32(UINT32_MAX, buf), "4294967295");
+}
+
+static void test_i32(void)
+{
+	EXPECT(fmt_i32(0, buf), "0");
+	EXPECT(fmt_i32(9, buf), "9");
+	EXPECT(fmt_i32(10, buf), "10");
+	EXPECT(fmt_i32(99, buf), "99");
+	EXPECT(fmt_i32(100, buf), "100");
+	EXPECT(fmt_i32(-5, buf), "-5");
+	EXPECT(fmt_i32(-100, buf), "-100");
+	EXPECT(fmt_i32(INT32_MAX, buf), "2147483647");
+	EXPECT(fmt_i32(INT32_MIN, buf), "-2147483648");
+}
+
+static void test_tenths(void)
+{
+	EXPECT(fmt_tenths(0, buf), "0.0");
+	EXPECT(fmt_tenths(9, buf), "0.9");
+	EXPECT(fmt_tenths(10, buf), "1.0");
+	EXPECT(fmt_tenths(99, buf), "9.9");
+	EXPECT(fmt_tenths(100, buf), "10.0");
+	EXPECT(fmt_tenths(257, buf), "25.7");
+	// below one the sign is kept
+	EXPECT(fmt_tenths(-5, buf), "-0.5");
+	EXPECT(fmt_tenths(-10, buf), "-1.0");
+	EXPECT(fmt_tenths(-257, buf), "-25.7");
+	EXPECT(fmt_tenths(INT32_MAX, buf), "214748364.7");
+	// the longest text of all, every byte of FMT_BUF
+	EXPECT(fmt_tenths(INT32_MIN, buf), "-214748364.8");
+	CHECK_EQ(fmt_tenths(INT32_MIN, buf) + 1, FMT_BUF);
+}
+
+int main(void)
+{
+	test_u32();
+	test_i32();
+	test_tenths();
+	return check_done("test_numfmt");
+}
@@ -0,0 +1,214 @@
+/*****************************************************************************
+ *   scope_find_trigger() and scope_decimate() on synthetic captures
+ *
+ ******************************************************************************/
+#include <math.h>
+#include <stdlib.h>
+
+#include "scope.h"
+#include "lpc17xx_gpdma.h"
+#include "check.h"
+
+#define LEN SCOPE_CAPTURE_LEN
+
+static uint32_t buf[LEN];
+
+/* AD0GDR word as the DMA stores it: result in bits 4..15, DONE in 31 */
+static uint32_t word(int v)
+{
+	if (v < 0)
+		v = 0;
+	if (v > 4095)
+		v = 4095;
+	return (1u << 31) | ((uint32_t)v << 4);
+}
+
+static void fill(int v)
+{
+	for (int i = 0; i < LEN; i++)
+		buf[i] = word(v);
+}
+
+/* low until edge, high from edge on */
+static void step(int edge, int lo, int hi)
+{
+	for (int i = 0; i < LEN; i++)
+		buf[i] = word(i < edge ? lo : hi);
+}
+
+static scope_cfg_t cfg(scope_slope_t slope, int level, int hyst)
+{
+	scope_cfg_t c = { slope, (uint16_t)level, (uint16_t)hyst, 0, 0 };
+	return c;
+}
+
+static void test_edges(void)
+{
+	scope_cfg_t rise = cfg(SCOPE_RISING, 2048, 64);
+	scope_cfg_t fall = cfg(SCOPE_FALLING, 2048, 64);
+
+	step(500, 1000, 3000);
+	CHECK_EQ(scope_find_trigger(buf, LEN, 0, LEN, &rise), 500);
+	CHECK_EQ(scope_find_trigger(buf, LEN, 0, LEN, &fall), -1);
+
+	step(700, 3000, 1000);
+	CHECK_EQ(scope_find_trigger(buf, LEN, 0, LEN, &fall), 700);
+	CHECK_EQ(scope_find_trigger(buf, LEN, 0, LEN, &rise), -1);
+
+	// exactly at level counts as crossed
+	step(300, 1000, 2048);
+	CHECK_EQ(scope_find_trigger(buf, LEN, 0, LEN, &rise), 300);
+}
+
+static void test_no_trigger(void)
+{
+	scope_cfg_t rise = cfg(SCOPE_RISING, 2048, 64);
+
+	fill(0);
+	CHECK_EQ(scope_find_trigger(buf, LEN, 0, LEN, &rise), -1);
+	fill(4095);
+	CHECK_EQ(scope_find_trigger(buf, LEN, 0, LEN, &rise), -1);
+	// starts high: never armed below level - hysteresis
+	step(1000, 3000, 4000);
+	CHECK_EQ(scope_find_trigger(buf, LEN, 0, LEN, &rise), -1);
+}
+
+static void test_noise(void)
+{
+	scope_cfg_t rise = cfg(SCOPE_RISING, 2048, 64);
+	int i;
+
+	// noise within the hysteresis never arms the trigger
+	srand(1);
+	for (i = 0; i < LEN; i++)
+		buf[i] = word(2048 - 63 + rand() % 127);
+	CHECK_EQ(scope_find_trigger(buf, LEN, 0, LEN, &rise), -1);
+
+	// noisy sine: one trigger per period near the upward crossing
+	for (i = 0; i < LEN; i++)
+		buf[i] = word(2048 + (int)(1500 * sin(2 * M_PI * (i - 100) / 400.0))
+				+ rand() % 81 - 40);
+	i = scope_find_trigger(buf, LEN, 0, LEN, &rise);
+	CHECK(i >= 100 - 10 && i <= 100 + 10);
+	i = scope_find_trigger(buf, LEN, 300, LEN, &rise);
+	CHECK(i >= 500 - 10 && i <= 500 + 10);
+
+	// chatter right after the edge does not fire again before rearming
+	step(600, 1000, 3000);
+	for (i = 601; i < 640; i += 2)
+		buf[i] = word(2000);
+	CHECK_EQ(scope_find_trigger(buf, LEN, 0, LEN, &rise), 600);
+	CHECK_EQ(scope_find_trigger(buf, LEN, 601, LEN, &rise), -1);
+}
+
+static void test_buffer_edges(void)
+{
+	scope_cfg_t rise = cfg(SCOPE_RISING, 2048, 64);
+
+	// first allowed position
+	step(200, 1000, 3000);
+	CHECK_EQ(scope_find_trigger(buf, LEN, 200, LEN, &rise), 200);
+	// the edge is before from and the signal then stays high
+	CHECK_EQ(scope_find_trigger(buf, LEN, 201, LEN, &rise), -1);
+
+	// last allowed position is to - 1
+	step(LEN - 1, 1000, 3000);
+	CHECK_EQ(scope_find_trigger(buf, LEN, 0, LEN, &rise), LEN - 1);
+	CHECK_EQ(scope_find_trigger(buf, LEN, 0, LEN - 1, &rise), -1);
+	// to past the end is clamped to len
+	CHECK_EQ(scope_find_trigger(buf, LEN, 0, LEN + 100, &rise), LEN - 1);
+
+	// an edge at index 0 has nothing to arm on
+	fill(3000);
+	CHECK_EQ(scope_find_trigger(buf, LEN, 0, LEN, &rise), -1);
+
+	// the same window scope_poll() searches for the slowest timebase
+	{
+		int span = SCOPE_WIDTH * 20;
+		int pre = span / 4;
+		int to = LEN - span + pre + 1;
+
+		step(to - 1, 1000, 3000);
+		CHECK_EQ(scope_find_trigger(buf, LEN, pre, to, &rise), to - 1);
+		step(to, 1000, 3000);
+		CHECK_EQ(scope_find_trigger(buf, LEN, pre, to, &rise), -1);
+	}
+}
+
+static void test_decimate(void)
+{
+	uint16_t out[SCOPE_WIDTH];
+	int i;
+
+	for (i = 0; i < LEN; i++)
+		buf[i] = word(i);
+
+	scope_decimate(buf, 0, 1, out, SCOPE_WIDTH);
+	for (i = 0; i < SCOPE_WIDTH; i++)
+		CHECK_EQ(out[i], i);
+
+	// average of 5 consecutive values i*5+7 .. i*5+11
+	scope_decimate(buf, 7, 5, out, SCOPE_WIDTH);
+	for (i = 0; i < SCOPE_WIDTH; i++)
+		CHECK_EQ(out[i], i * 5 + 9);
+
+	// last point ends on the last sample of the capture
+	scope_decimate(buf, LEN - SCOPE_WIDTH * 20, 20, out, SCOPE_WIDTH);
+	CHECK_EQ(out[SCOPE_WIDTH - 1], (2 * LEN - 21) / 2);
+
+	// full scale does not overflow the sum
+	fill(4095);
+	scope_decimate(buf, 0, 20, out, SCOPE_WIDTH);
+	CHECK_EQ(out[0], 4095);
+	CHECK_EQ(out[SCOPE_WIDTH - 1], 4095);
+
+	// DONE and overrun bits are not part of the value
+	for (i = 0; i < LEN; i++)
+		buf[i] = word(100) | (1u << 30);
+	scope_decimate(buf, 0, 2, out, 1);
+	CHECK_EQ(out[0], 100);
+}
+
+void DMA_IRQHandler(void);
+
+/* the DMA finishing the transfer set up last */
+static void dma_done(void)
+{
+	host_dma_tc = 1;
+	DMA_IRQHandler();
+}
+
+static void test_block(void)
+{
+	// the first spectrum block does not wait for the full scope capture
+	scope_enter();
+	CHECK_EQ(host_dma_size, SCOPE_CAPTURE_LEN);
+	CHECK(scope_block(256) == NULL);
+	CHECK_EQ(host_dma_size, 256);
+	CHECK(scope_block(256) == NULL);
+	CHECK_EQ(host_dma_size, 256);
+	dma_done();
+	CHECK(scope_block(256) != NULL);
+
+	// the next call starts the next capture
+	CHECK(scope_block(256) == NULL);
+	CHECK_EQ(host_dma_size, 256);
+
+	// a longer FFT starts over, a completed longer capture is used
+	CHECK(scope_block(1024) == NULL);
+	CHECK_EQ(host_dma_size, 1024);
+	dma_done();
+	CHECK(scope_block(512) != NULL);
+	scope_leave();
+}
+
+int main(void)
+{
+	test_edges();
+	test_no_trigger();
+	test_noise();
+	test_buffer_edges();
+	test_decimate();
+	test_block();
+	return check_done("test_scope");
+}
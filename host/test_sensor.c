@@ -0,0 +1,109 @@
+/*****************************************************************************
+ *   Sampling, scaling and sensor_find_joy() on a table of mock sensors
+ *
+ ******************************************************************************/
+#include "sensor.h"
+#include "check.h"
+
+static int starts;
+static int reads;
+static int started_before_read;
+static int32_t next_raw;
+
+static void mock_start(void)
+{
+	starts++;
+}
+
+static int32_t mock_read(void)
+{
+	started_before_read = starts > reads;
+	reads++;
+	return next_raw;
+}
+
+static const sensor_t table[] = {
+	{ .name = "plain", .read = mock_read, .scale = 1, .joy = 0x01 },
+	{ .name = "started", .start = mock_start, .read = mock_read, .scale = 10, .decimals = 1,
+	  .joy = 0x02 },
+	{ .name = "unscaled", .read = mock_read, .scale = 0, .joy = 0x04 },
+	{ .name = "twin", .read = mock_read, .scale = 1, .joy = 0x02 },
+	{ .name = "coarse", .read = mock_read, .scale = 100, .decimals = 1, .joy = 0x10 },
+};
+
+#define N (int)(sizeof(table) / sizeof(table[0]))
+
+static void reset(int32_t raw)
+{
+	starts = reads = started_before_read = 0;
+	next_raw = raw;
+}
+
+static void test_sample(void)
+{
+	// no start callback: one read, value passed through
+	reset(1234);
+	CHECK_EQ(sensor_sample(&table[0]), 1234);
+	CHECK_EQ(starts, 0);
+	CHECK_EQ(reads, 1);
+
+	// start runs once and before the read
+	reset(257);
+	CHECK_EQ(sensor_sample(&table[1]), 25);
+	CHECK_EQ(starts, 1);
+	CHECK_EQ(reads, 1);
+	CHECK(started_before_read);
+
+	// scaling truncates toward zero, also below zero
+	reset(-257);
+	CHECK_EQ(sensor_sample(&table[1]), -25);
+	reset(9);
+	CHECK_EQ(sensor_sample(&table[1]), 0);
+
+	// a scale of 0 or 1 leaves the value alone
+	reset(-42);
+	CHECK_EQ(sensor_sample(&table[2]), -42);
+	reset(-42);
+	CHECK_EQ(sensor_sample(&table[0]), -42);
+}
+
+static void test_read_scale(void)
+{
+	// sensor_read() is the raw half of sensor_sample()
+	reset(257);
+	CHECK_EQ(sensor_read(&table[1]), 257);
+	CHECK_EQ(starts, 1);
+	CHECK_EQ(reads, 1);
+	CHECK(started_before_read);
+	CHECK_EQ(sensor_scale(&table[1], 257), 25);
+	CHECK_EQ(sensor_scale(&table[2], 257), 257);
+
+	// the shown value keeps the sensor's decimals
+	CHECK_EQ(sensor_fixed(&table[1], 257), 257);
+	CHECK_EQ(sensor_fixed(&table[1], -257), -257);
+	CHECK_EQ(sensor_fixed(&table[4], 2571), 257);
+	CHECK_EQ(sensor_fixed(&table[4], -2579), -257);
+	CHECK_EQ(sensor_fixed(&table[0], 1234), 1234);
+	CHECK_EQ(sensor_fixed(&table[2], -42), -42);
+}
+
+static void test_find_joy(void)
+{
+	CHECK_EQ(sensor_find_joy(table, N, 0x01), 0);
+	CHECK_EQ(sensor_find_joy(table, N, 0x04), 2);
+	// the first entry wins when two share a direction
+	CHECK_EQ(sensor_find_joy(table, N, 0x02), 1);
+	CHECK_EQ(sensor_find_joy(table, N, 0x08), -1);
+	CHECK_EQ(sensor_find_joy(table, N, 0), -1);
+	// only the first n entries are searched
+	CHECK_EQ(sensor_find_joy(table, 2, 0x04), -1);
+	CHECK_EQ(sensor_find_joy(table, 0, 0x01), -1);
+}
+
+int main(void)
+{
+	test_sample();
+	test_read_scale();
+	test_find_joy();
+	return check_done("test_sensor");
+}
@@ -0,0 +1,210 @@
+/*****************************************************************************
+ *   The sensors[] table of main.c and the live graph's dispatch through
+ *   it: every entry is consistent with the history and trigger layout,
+ *   and each sensor's status line shows its value with its own fields.
+ *   Also the diagnostics screen, whose text must all land on the panel.
+ *
+ ******************************************************************************/
+#include <string.h>
+
+#define main fw_main
+#include "../src/main.c"
+#undef main
+
+#include "font5x7.h"
+// main.c defines the driver library's check_failed()
+#define check_failed checks_failed
+#include "check.h"
+
+static int32_t temp_raw;
+static uint32_t light_lux;
+
+/* ---- what main.c reads, set by the tests ---- */
+
+int32_t temp_read(void) { return temp_raw; }
+uint32_t light_read(void) { return light_lux; }
+
+int vib_get(vib_metrics_t* m)
+{
+	(void)m;
+	return 0;
+}
+
+void __WFI(void) {}
+void Timer0_Wait(uint32_t ms) { (void)ms; }
+void Timer0_us_Wait(uint32_t us) { (void)us; }
+void input_init(uint32_t (*getMsTicks)(void)) { (void)getMsTicks; }
+int input_get(input_event_t* ev) { (void)ev; return 0; }
+uint32_t input_dropped(void) { return 0; }
+uint32_t serial_write_nb(const uint8_t* data, uint32_t len) { (void)data; return len; }
+
+/* ---- reading text back from the panel ---- */
+
+/* the character drawn black on white at x, y; letters are all the same
+ * box in the host font and read back as '!' */
+static char char_at(int x, int y)
+{
+	for (int c = 0x20; c < 0x7f; c++) {
+		int match = 1;
+
+		for (int r = 0; match && r < 8; r++) {
+			for (int j = 0; match && j < 6; j++) {
+				oled_color_t want = (font5x7[c - 0x20][r] & (0x80 >> j)) ?
+						OLED_COLOR_BLACK : OLED_COLOR_WHITE;
+
+				match = oled_pixel(x + j, y + r) == want;
+			}
+		}
+		if (match)
+			return (char)c;
+	}
+	return '?';
+}
+
+/* the cells at x, y without the padding */
+static const char* text_at(int x, int y, int cells)
+{
+	static char text[OLED_DISPLAY_WIDTH / 6 + 1];
+	int n = 0;
+
+	for (int i = 0; i < cells; i++) {
+		char c = char_at(x + 6 * i, y);
+
+		if (c != ' ' || n > 0)
+			text[n++] = c;
+	}
+	text[n] = '\0';
+	return text;
+}
+
+static const char* field_text(const numfield_t* f)
+{
+	return text_at(f->x, f->y, f->cells);
+}
+
+/* one live graph sample of sensor i as mode 0 takes it */
+static void live_sample(int i)
+{
+	const sensor_t* s = &sensors[i];
+
+	oled_init();
+	draw_graph_outline(s->delimiter, OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+	show_reset(s);
+	show_sample(s, sensor_read(s));
+}
+
+static int sensor_named(const char* label)
+{
+	for (int i = 0; i < (int)NUM_SENSORS; i++)
+		if (strcmp(sensors[i].label, label) == 0)
+			return i;
+	return -1;
+}
+
+static void test_table(void)
+{
+	for (int i = 0; i < (int)NUM_SENSORS; i++) {
+		const sensor_t* s = &sensors[i];
+
+		// the joystick reaches every sensor
+		CHECK_EQ(sensor_find_joy(sensors, NUM_SENSORS, s->joy), i);
+		// an event window is exactly one record
+		CHECK_EQ(s->trig.pre + 1 + s->trig.post, BUFF_LEN);
+		CHECK_EQ(s->eeprom_addr, HIST_REGION(i));
+		CHECK(s->hist != NULL);
+		for (int k = 0; k < i; k++)
+			CHECK(s->hist != sensors[k].hist);
+		CHECK(s->read != NULL);
+		CHECK(s->min < s->max);
+		CHECK(s->decimals <= 1);
+		CHECK(s->period_ms > 0);
+		// every character lands where oled_putChar() draws it
+		CHECK(s->label_x + 6 * (strlen(s->label) - 1) < OLED_DISPLAY_WIDTH - 8);
+		CHECK(1 + 6 * (strlen(s->name) - 1) < OLED_DISPLAY_WIDTH - 8);
+	}
+}
+
+static void test_dispatch(void)
+{
+	int temp = sensor_named("Temperature");
+	int light = sensor_named("Light");
+	int poten = sensor_named("Potentiometer");
+	int vib_i = sensor_named("Vibration");
+
+	CHECK(temp >= 0 && light >= 0 && poten >= 0 && vib_i >= 0);
+
+	// tenths kept on screen, the stored value is whole degrees
+	temp_raw = 257;
+	live_sample(temp);
+	CHECK(strcmp(field_text(&f_value), "25.7") == 0);
+	CHECK_EQ(sensor_sample(&sensors[temp]), 25);
+	temp_raw = -5;
+	live_sample(temp);
+	CHECK(strcmp(field_text(&f_value), "-0.5") == 0);
+
+	light_lux = 431;
+	live_sample(light);
+	CHECK(strcmp(field_text(&f_value), "431") == 0);
+	CHECK_EQ(f_value.x, sensors[light].value_x);
+
+	// started conversion, result from the ADC data register
+	host_adc.ADDR[ADC_CHANNEL_0] = (1u << 31) | (4095u << 4);
+	live_sample(poten);
+	CHECK(strcmp(field_text(&f_value), "4095") == 0);
+
+	// the vibration sensor lays out and fills three fields
+	vib.rms_mg = 42;
+	vib.peak_mg = 130;
+	vib.crest_x10 = 31;
+	live_sample(vib_i);
+	CHECK(strcmp(field_text(&f_value), "42") == 0);
+	CHECK(strcmp(field_text(&f_peak), "130") == 0);
+	CHECK(strcmp(field_text(&f_crest), "3.1") == 0);
+	CHECK_EQ(f_value.cells, 4);
+}
+
+static void test_diag(void)
+{
+	// every number at its widest
+	histo_init(&h_sample, "sample", 2);
+	histo_init(&h_input, "input", 4);
+	histo_add(&h_sample, 12345);
+	histo_add(&h_input, 9);
+	h_input.count = 1234567;
+	mem[MEM_LOC].peak = 4096;
+	mem[MEM_LOC].stack = 28672;
+	fault_record.magic = FAULT_MAGIC;
+	fault_record.type = FAULT_USAGE;
+	trace_enable(1, 0);
+	// first frame 1 ms past the boot target
+	boot_cycles[BOOT_FIRST_FRAME] = (BOOT_TARGET_MS + 1) * (SystemCoreClock / 1000);
+
+	oled_init();
+	diag_draw();
+	CHECK_EQ(oled_chars_clipped, 0);
+	CHECK(strcmp(text_at(1, 1, 15), "!50  !99  !!!!") == 0);
+	CHECK(strcmp(text_at(1, 10, 9), "!!!!!! !!") == 0);
+	CHECK(strcmp(text_at(55, 10, 6), "1") == 0);
+	CHECK(strcmp(text_at(1, 19, 4), "####") == 0);
+	CHECK(strcmp(text_at(61, 19, 4), "####") == 0);
+	CHECK(strcmp(text_at(55, 28, 6), "######") == 0);
+	CHECK(strcmp(text_at(61, 37, 4), "9") == 0);
+	CHECK(strcmp(text_at(1, 46, 3), "!!!") == 0);
+	CHECK(strcmp(text_at(25, 46, 5), "4096") == 0);
+	CHECK(strcmp(text_at(61, 46, 5), "28672") == 0);
+	CHECK(strcmp(text_at(1, 55, 4), "! !4") == 0);
+
+	// on time, no B
+	boot_cycles[BOOT_FIRST_FRAME] = BOOT_TARGET_MS * (SystemCoreClock / 1000);
+	oled_init();
+	diag_draw();
+	CHECK(strcmp(text_at(1, 55, 4), "!4") == 0);
+}
+
+int main(void)
+{
+	test_table();
+	test_dispatch();
+	test_diag();
+	return check_done("test_sensor_table");
+}
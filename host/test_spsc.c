@@ -0,0 +1,161 @@
+/*****************************************************************************
+ *   spsc and pool under a real second thread: a producer thread stands in
+ *   for the interrupt, main() for the main loop. Every element must arrive
+ *   once, in order and intact; the throughput is printed. A side that
+ *   finds the queue full or empty yields, so one CPU is enough.
+ *
+ ******************************************************************************/
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "spsc.h"
+#include "pool.h"
+#include "check.h"
+
+#define ITEMS 4000000u
+#define BATCHES 1000000u
+#define BATCH 32
+
+typedef struct {
+	uint32_t seq;
+	uint32_t inv;
+	uint32_t mix;				// 12 bytes, a trace frame record
+} item_t;
+
+static item_t small_slots[4];
+static item_t large_slots[64];
+static spsc_t small = SPSC_INIT(small_slots);
+static spsc_t large = SPSC_INIT(large_slots);
+
+typedef struct {
+	uint32_t seq;
+	uint8_t fill[BATCH * 3];	// a vibration.c sample batch
+} batch_t;
+
+static batch_t blocks[8];
+static void* free_slots[8];
+static void* full_slots[8];
+static pool_t pool = POOL_INIT(free_slots);
+static spsc_t full = SPSC_INIT(full_slots);
+
+static double now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void* put_items(void* arg)
+{
+	spsc_t* q = arg;
+
+	for (uint32_t i = 0; i < ITEMS; i++) {
+		item_t it = { i, ~i, i * 2654435761u };
+		while (!spsc_put(q, &it))
+			sched_yield();
+	}
+	return NULL;
+}
+
+static void test_queue(spsc_t* q)
+{
+	pthread_t producer;
+	uint32_t bad = 0, next = 0;
+	uint32_t max_count = 0;
+	double t0, t;
+	item_t it;
+
+	spsc_reset(q);
+	t0 = now_ns();
+	pthread_create(&producer, NULL, put_items, q);
+	while (next < ITEMS) {
+		uint32_t c = spsc_count(q);
+		if (c > max_count)
+			max_count = c;
+		if (!spsc_get(q, &it)) {
+			sched_yield();
+			continue;
+		}
+		if (it.seq != next || it.inv != ~next || it.mix != next * 2654435761u)
+			bad++;
+		next++;
+	}
+	pthread_join(producer, NULL);
+	t = now_ns() - t0;
+
+	CHECK_EQ(bad, 0);
+	CHECK_EQ(next, ITEMS);
+	CHECK(max_count <= q->len);
+	CHECK_EQ(spsc_count(q), 0);
+	CHECK(!spsc_get(q, &it));
+	printf("  spsc len %2u: %6.1f M items/s, %5.1f ns/item, %u full puts\n",
+			q->len, ITEMS / t * 1e3, t / ITEMS, q->dropped);
+}
+
+static void* fill_batches(void* arg)
+{
+	(void)arg;
+	for (uint32_t i = 0; i < BATCHES; i++) {
+		batch_t* b;
+		while ((b = pool_alloc(&pool)) == NULL)
+			sched_yield();
+		b->seq = i;
+		for (int k = 0; k < BATCH * 3; k++)
+			b->fill[k] = (uint8_t)(i + k);
+		while (!spsc_put(&full, &b))
+			sched_yield();
+	}
+	return NULL;
+}
+
+static void test_pool(void)
+{
+	pthread_t producer;
+	uint32_t bad = 0, next = 0;
+	int outside = 0;
+	double t0, t;
+	batch_t* b;
+
+	pool_init(&pool, blocks, sizeof(blocks[0]), 8);
+	CHECK_EQ(pool_available(&pool), 8);
+	t0 = now_ns();
+	pthread_create(&producer, NULL, fill_batches, NULL);
+	while (next < BATCHES) {
+		if (!spsc_get(&full, &b)) {
+			sched_yield();
+			continue;
+		}
+		if (b < blocks || b >= blocks + 8)
+			outside++;
+		if (b->seq != next)
+			bad++;
+		for (int k = 0; k < BATCH * 3; k++) {
+			if (b->fill[k] != (uint8_t)(next + k)) {
+				bad++;
+				break;
+			}
+		}
+		pool_free(&pool, b);
+		next++;
+	}
+	pthread_join(producer, NULL);
+	t = now_ns() - t0;
+
+	CHECK_EQ(bad, 0);
+	CHECK_EQ(outside, 0);
+	CHECK_EQ(pool_available(&pool), 8);
+	CHECK_EQ(pool.free.dropped, 0);
+	printf("  pool 8 x %u B: %6.1f M batches/s, %5.1f ns/batch\n",
+			(unsigned)sizeof(batch_t), BATCHES / t * 1e3, t / BATCHES);
+}
+
+int main(void)
+{
+	test_queue(&small);
+	test_queue(&large);
+	test_pool();
+	return check_done("test_spsc");
+}
@@ -0,0 +1,75 @@
+/*****************************************************************************
+ *   trig_sample() windows: when an event is reported and how many samples
+ *   are counted as committed or skipped
+ *
+ ******************************************************************************/
+#include "trigger.h"
+#include "check.h"
+
+static const trig_cfg_t above = { TRIG_LEVEL_ABOVE, 30, 1, 14, 5 };
+static const trig_cfg_t rate = { TRIG_RATE, 100, 20, 3, 2 };
+
+/* feed n samples of value, return the number of windows reported */
+static int feed(trig_state_t* t, int32_t value, int n)
+{
+	int ready = 0;
+
+	while (n-- > 0)
+		ready += trig_sample(t, value);
+	return ready;
+}
+
+static void test_pre_window(void)
+{
+	trig_state_t t;
+
+	// an event in the first pre samples waits for the window to fill
+	trig_init(&t, &above);
+	CHECK_EQ(feed(&t, 35, 14), 0);
+	CHECK(!t.capturing);
+	// the 15th sample has 14 before it and fires, 5 more complete it
+	CHECK_EQ(feed(&t, 35, 1), 0);
+	CHECK(t.capturing);
+	CHECK_EQ(feed(&t, 35, 4), 0);
+	CHECK_EQ(feed(&t, 35, 1), 1);
+	CHECK_EQ(t.committed, 20);
+	CHECK_EQ(t.skipped, 0);
+
+	// still above: no new event until it drops below level - deadband
+	CHECK_EQ(feed(&t, 35, 30), 0);
+	CHECK_EQ(feed(&t, 20, 1), 0);
+	CHECK_EQ(feed(&t, 31, 1), 0);
+	CHECK_EQ(feed(&t, 31, 5), 1);
+	CHECK_EQ(t.committed + t.skipped, 20 + 30 + 1 + 6);
+}
+
+static void test_rate(void)
+{
+	trig_state_t t;
+
+	// a jump inside the first pre samples is not an event
+	trig_init(&t, &rate);
+	CHECK_EQ(feed(&t, 0, 1), 0);
+	CHECK_EQ(feed(&t, 200, 1), 0);
+	CHECK(!t.capturing);
+	CHECK_EQ(feed(&t, 200, 2), 0);
+	// one later is
+	CHECK_EQ(feed(&t, 0, 1), 0);
+	CHECK(t.capturing);
+	CHECK_EQ(feed(&t, 0, 2), 1);
+	CHECK_EQ(t.committed, 6);
+
+	// trig_init() starts the pre window over
+	trig_init(&t, &rate);
+	CHECK_EQ(t.committed, 0);
+	CHECK_EQ(feed(&t, 0, 3), 0);
+	CHECK_EQ(feed(&t, 500, 1), 0);
+	CHECK(t.capturing);
+}
+
+int main(void)
+{
+	test_pre_window();
+	test_rate();
+	return check_done("test_trigger");
+}
@@ -0,0 +1,69 @@
+#!/usr/bin/env python
+"""Write tour.lpct, the trace "make check" replays.
+
+A made up board session of 226 s: recording starts in the diagnostics mode,
+SW3 then steps through every mode, with a sensor change in the live graph,
+one event recorded in mode 1 at the 10 s interval and some panning in mode
+2, and the trace is toggled off in the diagnostics mode again. Only what
+replay.c reads is written, the mode and the input events and a sample per
+second of the temperature and the trimpot; without the per period
+counters the board column of its report is 0.
+
+    python host/traces/tour.py host/traces/tour.lpct
+
+Regenerate tour.out and tour.json after changing it (see the Makefile).
+"""
+import os
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                                '..', '..', 'tools'))
+import trace_format as tf
+
+# src/input.h sources, host/include joystick.h and rotary.h codes
+JOY, SW3, ROT = 0, 1, 2
+CENTER, UP, RIGHT, LEFT = 0x01, 0x02, 0x10, 0x08
+ROT_LEFT = 2
+
+MODE_DIAG = 5
+START = 10000
+
+EVENTS = [
+    (500, SW3, 0),          # live graph, temperature
+    (5000, JOY, RIGHT),     # next sensor
+    (9000, SW3, 0),         # record dialog
+    (9800, JOY, CENTER),    # start recording every 10 s
+    (215000, SW3, 0),       # replay, a window is 20 samples
+    (216000, JOY, LEFT),
+    (217000, ROT, ROT_LEFT),
+    (219000, SW3, 0),       # scope
+    (221000, SW3, 0),       # spectrum
+    (223000, SW3, 0),       # diagnostics
+    (225000, JOY, UP),      # trace off
+]
+END = 226000
+
+
+def main(argv):
+    if len(argv) != 2:
+        sys.stderr.write(__doc__)
+        return 2
+    recs = [(START, tf.MODE, MODE_DIAG, 0, 0)]
+    for ms, src, code in EVENTS:
+        recs.append((START + ms, tf.INPUT, src, code, 0))
+    for ms in range(0, END, 1000):
+        recs.append((START + ms, tf.SAMPLE, 0, 0, 26 + (ms // 1000) % 7))
+        recs.append((START + ms + 1, tf.SAMPLE, 2, 0,
+                     500 + (ms // 1000) % 7 * 300))
+    # stable sort: per tick the order above
+    recs.sort(key=lambda r: r[0])
+
+    out = tf.TraceWriter(argv[1])
+    for rec in recs:
+        out.write(rec)
+    out.close()
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))
@@ -130,6 +130,13 @@ extern void __main(void);
 extern int main(void);
 //*****************************************************************************
 //
+// Stack painting for the high-water mark, see memstat.c
+//
+//*****************************************************************************
+extern void mem_paint_stack(void);
+extern void prof_start(void);
+//*****************************************************************************
+//
 // External declaration for the pointer to the stack top from the Linker Script
 //
 //*****************************************************************************
@@ -206,16 +213,43 @@ void (* const g_pfnVectors[])(void) = {
 
 //*****************************************************************************
 //
-// The following are constructs created by the linker, indicating where the
-// the "data" and "bss" segments reside in memory.  The initializers for the
-// for the "data" segment resides immediately following the "text" segment.
+// Functions to carry out the initialization of RW and BSS data sections. These
+// are written as separate functions rather than being inlined within the
+// ResetISR() function in order to cope with MCUs with multiple banks of
+// memory.
+//
+//*****************************************************************************
+__attribute__ ((section(".after_vectors")))
+void data_init(unsigned int romstart, unsigned int start, unsigned int len) {
+    unsigned int *pulDest = (unsigned int*) start;
+    unsigned int *pulSrc = (unsigned int*) romstart;
+    unsigned int loop;
+    for (loop = 0; loop < len; loop = loop + 4)
+        *pulDest++ = *pulSrc++;
+}
+
+__attribute__ ((section(".after_vectors")))
+void bss_init(unsigned int start, unsigned int len) {
+    unsigned int *pulDest = (unsigned int*) start;
+    unsigned int loop;
+    for (loop = 0; loop < len; loop = loop + 4)
+        *pulDest++ = 0;
+}
+
+//*****************************************************************************
+//
+// The following symbols are constructs generated by the linker, indicating
+// the location of various points in the "Global Section Table". This table is
+// created by the linker via the Code Red managed linker script mechanism. It
+// contains the load address, execution address and length of each RW data
+// section (.data, .data_RAM2, which also carry .ramfunc code) and the
+// execution address and length of each BSS section (.bss, .bss_RAM2).
 //
 //*****************************************************************************
-extern unsigned long _etext;
-extern unsigned long _data;
-extern unsigned long _edata;
-extern unsigned long _bss;
-extern unsigned long _ebss;
+extern unsigned int __data_section_table;
+extern unsigned int __data_section_table_end;
+extern unsigned int __bss_section_table;
+extern unsigned int __bss_section_table_end;
 
 //*****************************************************************************
 // Reset entry point for your code.
@@ -223,32 +257,41 @@ extern unsigned long _ebss;
 // library.
 //
 //*****************************************************************************
+__attribute__ ((section(".after_vectors")))
 void
 ResetISR(void) {
-    unsigned long *pulSrc, *pulDest;
+    unsigned int LoadAddr, ExeAddr, SectionLen;
+    unsigned int *SectionTableAddr;
 
     //
-    // Copy the data segment initializers from flash to SRAM.
+    // Boot time is counted from here
     //
-    pulSrc = &_etext;
-    for(pulDest = &_data; pulDest < &_edata; )
-    {
-        *pulDest++ = *pulSrc++;
+    prof_start();
+
+    //
+    // Copy the data sections (RamLoc32 and RamAHB32) from flash to SRAM.
+    //
+    SectionTableAddr = &__data_section_table;
+    while (SectionTableAddr < &__data_section_table_end) {
+        LoadAddr = *SectionTableAddr++;
+        ExeAddr = *SectionTableAddr++;
+        SectionLen = *SectionTableAddr++;
+        data_init(LoadAddr, ExeAddr, SectionLen);
+    }
+
+    //
+    // Zero fill the bss segments
+    //
+    while (SectionTableAddr < &__bss_section_table_end) {
+        ExeAddr = *SectionTableAddr++;
+        SectionLen = *SectionTableAddr++;
+        bss_init(ExeAddr, SectionLen);
     }
 
     //
-    // Zero fill the bss segment.  This is done with inline assembly since this
-    // will clear the value of pulDest if it is not kept in a register.
+    // Paint the unused stack so its deepest use can be measured
     //
-    __asm("    ldr     r0, =_bss\n"
-          "    ldr     r1, =_ebss\n"
-          "    mov     r2, #0\n"
-          "    .thumb_func\n"
-          "zero_loop:\n"
-          "        cmp     r0, r1\n"
-          "        it      lt\n"
-          "        strlt   r2, [r0], #4\n"
-          "        blt     zero_loop");
+    mem_paint_stack();
 
 #ifdef __USE_CMSIS
 	SystemInit();
@@ -0,0 +1,85 @@
+#include "LPC17xx.h"
+
+#include "fault.h"
+
+/* not zeroed at reset, so it outlives the reset that follows a fault */
+fault_record_t fault_record __attribute__ ((section(".noinit.fault")));
+
+/* r0 - stacked exception frame, r1 - fault type */
+void fault_save(uint32_t* frame, uint32_t type) __attribute__ ((noreturn, used));
+
+void fault_save(uint32_t* frame, uint32_t type)
+{
+	fault_record.type = type;
+	fault_record.r0 = frame[0];
+	fault_record.r1 = frame[1];
+	fault_record.r2 = frame[2];
+	fault_record.r3 = frame[3];
+	fault_record.r12 = frame[4];
+	fault_record.lr = frame[5];
+	fault_record.pc = frame[6];
+	fault_record.psr = frame[7];
+	fault_record.cfsr = SCB_CFSR;
+	fault_record.hfsr = SCB_HFSR;
+	fault_record.mmfar = SCB_MMFAR;
+	fault_record.bfar = SCB_BFAR;
+	fault_record.magic = FAULT_MAGIC;
+
+	NVIC_SystemReset();
+	while (1);
+}
+
+#define STR(x) #x
+#define XSTR(x) STR(x)
+
+/* pass the stack the frame was pushed to (LR bit 2) on to fault_save() */
+#define FAULT_HANDLER(name, type) \
+	__attribute__ ((naked)) void name(void) \
+	{ \
+		__asm volatile ( \
+			"tst lr, #4\n" \
+			"ite eq\n" \
+			"mrseq r0, msp\n" \
+			"mrsne r0, psp\n" \
+			"mov r1, #" XSTR(type) "\n" \
+			"b fault_save\n"); \
+	}
+
+FAULT_HANDLER(HardFault_Handler, FAULT_HARD)
+FAULT_HANDLER(MemManage_Handler, FAULT_MEM)
+FAULT_HANDLER(BusFault_Handler, FAULT_BUS)
+FAULT_HANDLER(UsageFault_Handler, FAULT_USAGE)
+
+/******************************************************************************
+ *
+ * Description:
+ *    Route MPU, bus and usage faults to their own handlers instead of
+ *    escalating them all to hard fault
+ *
+ *****************************************************************************/
+void fault_init(void)
+{
+	SCB_SHCSR |= (1 << 16) | (1 << 17) | (1 << 18);
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Whether a fault was recorded before the last reset
+ *
+ *****************************************************************************/
+int fault_valid(void)
+{
+	return fault_record.magic == FAULT_MAGIC;
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Forget the recorded fault
+ *
+ *****************************************************************************/
+void fault_clear(void)
+{
+	fault_record.magic = 0;
+}
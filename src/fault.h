@@ -0,0 +1,40 @@
+/*****************************************************************************
+ *   Post-mortem fault record. The fault handlers save the stacked context
+ *   and fault status registers to .noinit, which reset does not clear, and
+ *   reset the MCU; the record is then read back after boot.
+ *
+ ******************************************************************************/
+#ifndef FAULT_H_
+#define FAULT_H_
+
+#include "lpc_types.h"
+
+#define FAULT_MAGIC 0xFA017ED0
+
+#define SCB_SHCSR (*(volatile uint32_t*)0xE000ED24)
+#define SCB_CFSR  (*(volatile uint32_t*)0xE000ED28)
+#define SCB_HFSR  (*(volatile uint32_t*)0xE000ED2C)
+#define SCB_MMFAR (*(volatile uint32_t*)0xE000ED34)
+#define SCB_BFAR  (*(volatile uint32_t*)0xE000ED38)
+
+/* fault types, plain numbers so the handlers can use them in asm */
+#define FAULT_HARD 1
+#define FAULT_MEM 2
+#define FAULT_BUS 3
+#define FAULT_USAGE 4
+
+typedef struct {
+	uint32_t magic;		// FAULT_MAGIC when the record is valid
+	uint32_t type;		// FAULT_HARD .. FAULT_USAGE
+	uint32_t r0, r1, r2, r3, r12;
+	uint32_t lr, pc, psr;	// stacked by the exception entry
+	uint32_t cfsr, hfsr, mmfar, bfar;
+} fault_record_t;
+
+extern fault_record_t fault_record;
+
+void fault_init(void);
+int fault_valid(void);
+void fault_clear(void);
+
+#endif /* FAULT_H_ */
@@ -0,0 +1,152 @@
+#include "fft.h"
+#include "intmath.h"
+
+/* sin(2*pi*k/FFT_MAX_N) in Q15 for the first quarter wave, k = 0..128 */
+static const int16_t sin_quarter[FFT_MAX_N / 4 + 1] = {
+		0, 402, 804, 1206, 1608, 2009, 2411, 2811,
+		3212, 3612, 4011, 4410, 4808, 5205, 5602, 5998,
+		6393, 6787, 7180, 7571, 7962, 8351, 8740, 9127,
+		9512, 9896, 10279, 10660, 11039, 11417, 11793, 12167,
+		12540, 12910, 13279, 13646, 14010, 14373, 14733, 15091,
+		15447, 15800, 16151, 16500, 16846, 17190, 17531, 17869,
+		18205, 18538, 18868, 19195, 19520, 19841, 20160, 20475,
+		20788, 21097, 21403, 21706, 22006, 22302, 22595, 22884,
+		23170, 23453, 23732, 24008, 24279, 24548, 24812, 25073,
+		25330, 25583, 25833, 26078, 26320, 26557, 26791, 27020,
+		27246, 27467, 27684, 27897, 28106, 28311, 28511, 28707,
+		28899, 29086, 29269, 29448, 29622, 29792, 29957, 30118,
+		30274, 30425, 30572, 30715, 30853, 30986, 31114, 31238,
+		31357, 31471, 31581, 31686, 31786, 31881, 31972, 32058,
+		32138, 32214, 32286, 32352, 32413, 32470, 32522, 32568,
+		32610, 32647, 32679, 32706, 32729, 32746, 32758, 32766,
+		32767
+};
+
+/* sin/cos of 2*pi*k/FFT_MAX_N for k = 0..FFT_MAX_N-1 */
+static int32_t sin_q15(int k)
+{
+	k &= FFT_MAX_N - 1;
+	if (k < FFT_MAX_N / 4)
+		return sin_quarter[k];
+	if (k < FFT_MAX_N / 2)
+		return sin_quarter[FFT_MAX_N / 2 - k];
+	if (k < 3 * FFT_MAX_N / 4)
+		return -sin_quarter[k - FFT_MAX_N / 2];
+	return -sin_quarter[FFT_MAX_N - k];
+}
+
+static int32_t cos_q15(int k)
+{
+	return sin_q15(k + FFT_MAX_N / 4);
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Apply a Hann window in place
+ *
+ * Params:
+ *   [in/out] re - 2^log2n samples
+ *   [in] log2n - log2 of the number of samples
+ *
+ *****************************************************************************/
+void fft_window(int16_t* re, int log2n)
+{
+	int n = 1 << log2n;
+	int step = FFT_MAX_N >> log2n;
+	int i;
+
+	for (i = 0; i < n; i++) {
+		int32_t w = (32767 - cos_q15(i * step)) >> 1;
+		re[i] = (int16_t)((re[i] * w) >> 15);
+	}
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    In place decimation in time FFT. Every stage halves its output so the
+ *    result is the DFT scaled by 1/n and cannot overflow.
+ *
+ * Params:
+ *   [in/out] re - real parts, 2^log2n entries
+ *   [in/out] im - imaginary parts, 2^log2n entries
+ *   [in] log2n - FFT_LOG2_MIN..FFT_LOG2_MAX
+ *
+ *****************************************************************************/
+__RAMFUNC void fft_q15(int16_t* re, int16_t* im, int log2n)
+{
+	int n = 1 << log2n;
+	int i, j, k, size;
+	int16_t t;
+
+	// bit reversed reordering
+	for (i = 1, j = 0; i < n; i++) {
+		int bit = n >> 1;
+		while (j & bit) {
+			j ^= bit;
+			bit >>= 1;
+		}
+		j |= bit;
+		if (i < j) {
+			t = re[i]; re[i] = re[j]; re[j] = t;
+			t = im[i]; im[i] = im[j]; im[j] = t;
+		}
+	}
+
+	for (size = 2; size <= n; size <<= 1) {
+		int half = size >> 1;
+		int step = FFT_MAX_N / size;
+
+		for (k = 0; k < half; k++) {
+			int32_t wr = cos_q15(k * step);
+			int32_t wi = -sin_q15(k * step);
+
+			for (i = k; i < n; i += size) {
+				int32_t tr, ti;
+
+				j = i + half;
+				tr = (wr * re[j] - wi * im[j]) >> 15;
+				ti = (wr * im[j] + wi * re[j]) >> 15;
+				re[j] = (int16_t)((re[i] - tr) >> 1);
+				im[j] = (int16_t)((im[i] - ti) >> 1);
+				re[i] = (int16_t)((re[i] + tr) >> 1);
+				im[i] = (int16_t)((im[i] + ti) >> 1);
+			}
+		}
+	}
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Magnitude of the first n bins
+ *
+ *****************************************************************************/
+void fft_magnitude(const int16_t* re, const int16_t* im, uint16_t* mag, int n)
+{
+	int i;
+
+	for (i = 0; i < n; i++)
+		mag[i] = (uint16_t)isqrt32((uint32_t)(re[i] * re[i]) + (uint32_t)(im[i] * im[i]));
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    log2(v) in quarter steps (0 for v <= 1), i.e. about 1.5 dB per step
+ *
+ *****************************************************************************/
+uint8_t fft_log2_q2(uint32_t v)
+{
+	uint8_t bits = 0;
+
+	if (v <= 1)
+		return 0;
+	while (v >> (bits + 1))
+		bits++;
+	// two bits below the leading one give the fraction
+	if (bits >= 2)
+		return (uint8_t)(bits * 4 + ((v >> (bits - 2)) & 0x03));
+	return (uint8_t)(bits * 4 + ((v << (2 - bits)) & 0x03));
+}
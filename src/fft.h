@@ -0,0 +1,20 @@
+/*****************************************************************************
+ *   Fixed point (Q15) radix-2 FFT for 64 to 512 real ADC samples
+ *
+ ******************************************************************************/
+#ifndef FFT_H_
+#define FFT_H_
+
+#include "lpc_types.h"
+#include "sections.h"
+
+#define FFT_LOG2_MIN 6
+#define FFT_LOG2_MAX 9
+#define FFT_MAX_N (1 << FFT_LOG2_MAX)
+
+void fft_window(int16_t* re, int log2n);
+__RAMFUNC void fft_q15(int16_t* re, int16_t* im, int log2n);
+void fft_magnitude(const int16_t* re, const int16_t* im, uint16_t* mag, int n);
+uint8_t fft_log2_q2(uint32_t v);
+
+#endif /* FFT_H_ */
@@ -0,0 +1,78 @@
+#include "histo.h"
+
+/******************************************************************************
+ *
+ * Description:
+ *    Clear a histogram
+ *
+ * Params:
+ *   [in] h - histogram
+ *   [in] name - tag used when it is exported
+ *   [in] width - bucket width
+ *
+ *****************************************************************************/
+void histo_init(histo_t* h, const char* name, uint16_t width)
+{
+	int i;
+
+	h->name = name;
+	h->width = width;
+	for (i = 0; i < HISTO_BUCKETS; i++)
+		h->bucket[i] = 0;
+	h->over = 0;
+	h->count = 0;
+	h->max = 0;
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Count one value
+ *
+ * Params:
+ *   [in] h - histogram
+ *   [in] value - measured value
+ *
+ *****************************************************************************/
+void histo_add(histo_t* h, uint32_t value)
+{
+	uint32_t i = value / h->width;
+
+	if (i < HISTO_BUCKETS)
+		h->bucket[i]++;
+	else
+		h->over++;
+	h->count++;
+	if (value > h->max)
+		h->max = value;
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Upper bound of a percentile, resolved to the bucket edge
+ *
+ * Params:
+ *   [in] h - histogram
+ *   [in] pct - percentile, 1 to 100
+ *
+ * Returns:
+ *   End of the bucket holding the percentile, the maximum if that falls in
+ *   the overflow, 0 if the histogram is empty
+ *
+ *****************************************************************************/
+uint32_t histo_percentile(const histo_t* h, uint8_t pct)
+{
+	uint32_t need = (h->count * pct + 99) / 100;
+	uint32_t seen = 0;
+	int i;
+
+	if (h->count == 0)
+		return 0;
+	for (i = 0; i < HISTO_BUCKETS; i++) {
+		seen += h->bucket[i];
+		if (seen >= need)
+			return (uint32_t)(i + 1) * h->width;
+	}
+	return h->max;
+}
@@ -0,0 +1,26 @@
+/*****************************************************************************
+ *   Fixed bucket histograms for timing measurements in ms. Bucket i counts
+ *   values in [i * width, (i + 1) * width), the rest go to over.
+ *
+ ******************************************************************************/
+#ifndef HISTO_H_
+#define HISTO_H_
+
+#include "lpc_types.h"
+
+#define HISTO_BUCKETS 16
+
+typedef struct {
+	const char* name;		// used as the export tag
+	uint16_t width;			// bucket width
+	uint32_t bucket[HISTO_BUCKETS];
+	uint32_t over;			// values >= HISTO_BUCKETS * width
+	uint32_t count;
+	uint32_t max;
+} histo_t;
+
+void histo_init(histo_t* h, const char* name, uint16_t width);
+void histo_add(histo_t* h, uint32_t value);
+uint32_t histo_percentile(const histo_t* h, uint8_t pct);
+
+#endif /* HISTO_H_ */
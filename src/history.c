@@ -0,0 +1,361 @@
+#include "eeprom.h"
+
+#include "history.h"
+#include "i2c_bus.h"
+#include "sections.h"
+
+/* one sequential read of up to HIST_CHUNK_RECORDS records */
+static uint8_t chunk[HIST_CHUNK_RECORDS * HIST_REC_BYTES] __BSS_AHB;
+
+uint32_t hist_bytes_written;
+
+static int read_bytes(uint8_t* buf, uint16_t addr, uint16_t len)
+{
+	int16_t n;
+
+	i2c_bus_lock();
+	n = eeprom_read(buf, addr, len);
+	i2c_bus_unlock();
+	return (n == len) ? 0 : 1;
+}
+
+static int write_bytes(uint8_t* buf, uint16_t addr, uint16_t len)
+{
+	int16_t n;
+
+	i2c_bus_lock();
+	n = eeprom_write(buf, addr, len);
+	i2c_bus_unlock();
+	hist_bytes_written += len;
+	return (n == len) ? 0 : 1;
+}
+
+static uint32_t get32(const uint8_t* b)
+{
+	return ((uint32_t)b[0] << 24) | ((uint32_t)b[1] << 16) | ((uint32_t)b[2] << 8) | b[3];
+}
+
+static void put32(uint8_t* b, uint32_t v)
+{
+	b[0] = (uint8_t)(v >> 24);
+	b[1] = (uint8_t)(v >> 16);
+	b[2] = (uint8_t)(v >> 8);
+	b[3] = (uint8_t)v;
+}
+
+static int full(const hist_log_t* log)
+{
+	return log->lapped || log->total >= HIST_RECORDS;
+}
+
+static uint16_t records(const hist_log_t* log)
+{
+	return full(log) ? HIST_RECORDS : (uint16_t)log->total;
+}
+
+/* slot of the oldest record */
+static uint16_t first_slot(const hist_log_t* log)
+{
+	return full(log) ? (uint16_t)(log->total % HIST_RECORDS) : 0;
+}
+
+static uint16_t rec_addr(const hist_log_t* log, uint16_t slot)
+{
+	return log->base + slot * HIST_REC_BYTES;
+}
+
+static int slot_seq(const hist_log_t* log, uint16_t slot, uint32_t* seq)
+{
+	uint8_t b[4];
+
+	if (read_bytes(b, rec_addr(log, slot), 4) != 0)
+		return 1;
+	*seq = get32(b);
+	return 0;
+}
+
+/* Drop whatever the region holds: with slot 0 invalid the log is empty.
+ * The layout word goes last, so a reset in between repeats the clear. */
+static int clear_region(hist_log_t* log)
+{
+	uint8_t b[4];
+
+	put32(b, 0xFFFFFFFF);
+	if (write_bytes(b, rec_addr(log, 0), 4) != 0)
+		return 1;
+	put32(b, HIST_MAGIC);
+	return write_bytes(b, log->dir, 4);
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Attach to the log of a region: check its layout word, find the newest
+ *    record and read its time. The index itself is built by hist_build().
+ *
+ *    Record n goes to slot n modulo HIST_RECORDS, so the slots from 0 up
+ *    to the newest record hold slot 0's number plus their slot and the
+ *    slots after it the previous lap. A binary search for the end of that
+ *    run reads 7 sequence numbers. After the sequence wraps to 0 the slot
+ *    past the run still holds the lap before the wrap, which tells a full
+ *    ring from a new log.
+ *
+ * Params:
+ *   [in] log - log state
+ *   [in] base - region start, HIST_REGION(sensor)
+ *   [in] now_s - seconds since boot
+ *
+ * Returns:
+ *   0 on success, 1 on EEPROM error
+ *
+ *****************************************************************************/
+int hist_open(hist_log_t* log, uint16_t base, uint32_t now_s)
+{
+	uint8_t b[4];
+	uint32_t seq0, seq;
+	uint16_t lo, hi, mid;
+
+	log->base = base;
+	log->dir = (uint16_t)(((base - HIST_DIR_BYTES) / HIST_REGION_BYTES) * 4);
+	log->total = 0;
+	log->lapped = 0;
+	log->epoch = 0;
+	log->built = 0;
+
+	// an older layout or erased EEPROM: start an empty log
+	if (read_bytes(b, log->dir, 4) != 0)
+		return 1;
+	if (get32(b) != HIST_MAGIC)
+		return clear_region(log);
+
+	// a cleared or erased slot reads as all ones, no multiple of HIST_RECORDS
+	if (slot_seq(log, 0, &seq0) != 0)
+		return 1;
+	if (seq0 % HIST_RECORDS != 0)
+		return 0;
+
+	// slot lo continues the run from slot 0, slot hi does not
+	lo = 0;
+	hi = HIST_RECORDS;
+	while (hi - lo > 1) {
+		mid = (lo + hi) / 2;
+		if (slot_seq(log, mid, &seq) != 0)
+			return 1;
+		if (seq == seq0 + mid)
+			lo = mid;
+		else
+			hi = mid;
+	}
+	log->total = seq0 + lo + 1;
+	if (log->total == HIST_SEQ_WRAP) {
+		log->total = 0;
+		log->lapped = 1;
+	}
+	else if (seq0 == 0 && lo < HIST_RECORDS - 1) {
+		if (slot_seq(log, lo + 1, &seq) != 0)
+			return 1;
+		log->lapped = (seq == HIST_SEQ_WRAP - HIST_RECORDS + lo + 1);
+	}
+
+	if (read_bytes(b, rec_addr(log, lo) + HIST_TIME_OFF, 4) != 0)
+		return 1;
+	// keep log time increasing across power cycles
+	log->epoch = get32(b) + 1 - now_s;
+	return 0;
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Append a record, overwriting the oldest once the region is full, and
+ *    keep the index up to date if it has been built
+ *
+ * Params:
+ *   [in] log - log state
+ *   [in] samples - HIST_REC_SAMPLES samples, oldest first
+ *   [in] period_s - sample period
+ *   [in] now_s - seconds since boot of the last sample
+ *
+ * Returns:
+ *   0 on success, 1 on EEPROM error
+ *
+ *****************************************************************************/
+int hist_append(hist_log_t* log, const uint16_t* samples, uint16_t period_s, uint32_t now_s)
+{
+	uint8_t rec[HIST_REC_BYTES];
+	uint16_t slot = (uint16_t)(log->total % HIST_RECORDS);
+	uint32_t t = log->epoch + now_s;
+	int i;
+
+	put32(rec, log->total);
+	put32(rec + HIST_TIME_OFF, t);
+	rec[8] = (uint8_t)(period_s >> 8);
+	rec[9] = (uint8_t)period_s;
+	rec[10] = 0;
+	rec[11] = HIST_REC_SAMPLES;
+	for (i = 0; i < HIST_REC_SAMPLES; i++) {
+		rec[HIST_HDR_BYTES + i*2] = (uint8_t)(samples[i] >> 8);
+		rec[HIST_HDR_BYTES + i*2 + 1] = (uint8_t)samples[i];
+	}
+	// the sequence number makes it the newest, no directory update
+	if (write_bytes(rec, rec_addr(log, slot), sizeof(rec)) != 0)
+		return 1;
+
+	if (++log->total == HIST_SEQ_WRAP) {
+		log->total = 0;
+		log->lapped = 1;
+	}
+	log->time_s[slot] = t;
+	return 0;
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Read the samples of the newest record
+ *
+ * Params:
+ *   [in] log - log state
+ *   [out] samples - HIST_REC_SAMPLES samples
+ *
+ * Returns:
+ *   0 on success, 1 if the log is empty or on EEPROM error
+ *
+ *****************************************************************************/
+int hist_latest(hist_log_t* log, uint16_t* samples)
+{
+	if (records(log) == 0)
+		return 1;
+	return hist_fetch(log, hist_samples(log) - HIST_REC_SAMPLES, HIST_REC_SAMPLES, 1,
+			samples, NULL);
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Build the RAM index by reading the time of every record. Appends keep
+ *    it current afterwards.
+ *
+ * Params:
+ *   [in] log - log state
+ *   [in,out] bytes - incremented by the number of bytes read, may be NULL
+ *
+ * Returns:
+ *   0 on success, 1 on EEPROM error
+ *
+ *****************************************************************************/
+int hist_build(hist_log_t* log, uint32_t* bytes)
+{
+	uint16_t n = records(log);
+	uint16_t first = first_slot(log);
+	uint8_t b[4];
+	uint16_t i, slot;
+
+	for (i = 0; i < n; i++) {
+		slot = (first + i) % HIST_RECORDS;
+		if (read_bytes(b, rec_addr(log, slot) + HIST_TIME_OFF, 4) != 0)
+			return 1;
+		log->time_s[slot] = get32(b);
+	}
+	if (bytes != NULL)
+		*bytes += n * 4;
+	log->built = 1;
+	return 0;
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Number of samples in the log
+ *
+ *****************************************************************************/
+uint32_t hist_samples(const hist_log_t* log)
+{
+	return (uint32_t)records(log) * HIST_REC_SAMPLES;
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Log time of the record holding a sample
+ *
+ * Params:
+ *   [in] log - log state, index built
+ *   [in] pos - sample position, 0 is the oldest sample
+ *
+ *****************************************************************************/
+uint32_t hist_time_at(const hist_log_t* log, uint32_t pos)
+{
+	uint16_t slot = (first_slot(log) + pos / HIST_REC_SAMPLES) % HIST_RECORDS;
+
+	return log->built ? log->time_s[slot] : 0;
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Fetch a range of samples, averaged in groups. Each read covers up to
+ *    HIST_CHUNK_RECORDS consecutive slots and starts and ends on the first
+ *    and last sample wanted, so only the region wrap or the chunk size
+ *    split it.
+ *
+ * Params:
+ *   [in] log - log state
+ *   [in] from - first sample position, 0 is the oldest sample
+ *   [in] n - number of samples, a multiple of group
+ *   [in] group - samples averaged into each output value
+ *   [out] out - n / group values
+ *   [in,out] bytes - incremented by the number of bytes read, may be NULL
+ *
+ * Returns:
+ *   0 on success, 1 if the range is outside the log or on EEPROM error
+ *
+ *****************************************************************************/
+int hist_fetch(hist_log_t* log, uint32_t from, uint16_t n, uint16_t group,
+		uint16_t* out, uint32_t* bytes)
+{
+	uint16_t first = first_slot(log);
+	uint32_t acc = 0;
+	uint16_t acc_n = 0;
+	uint16_t o = 0;
+
+	if (group == 0 || from + n > hist_samples(log))
+		return 1;
+
+	while (n > 0) {
+		uint16_t s = (uint16_t)(from % HIST_REC_SAMPLES);
+		uint16_t slot = (uint16_t)((first + from / HIST_REC_SAMPLES) % HIST_RECORDS);
+		uint16_t nrec = HIST_RECORDS - slot;
+		uint16_t cnt, last, start, end, k;
+
+		if (nrec > HIST_CHUNK_RECORDS)
+			nrec = HIST_CHUNK_RECORDS;
+		cnt = nrec * HIST_REC_SAMPLES - s;
+		if (cnt > n)
+			cnt = n;
+		// sample index counted from the start of the first record read
+		last = s + cnt - 1;
+		start = rec_addr(log, slot) + HIST_HDR_BYTES + s * 2;
+		end = rec_addr(log, slot + last / HIST_REC_SAMPLES) + HIST_HDR_BYTES
+				+ (last % HIST_REC_SAMPLES + 1) * 2;
+		if (read_bytes(chunk, start, end - start) != 0)
+			return 1;
+		if (bytes != NULL)
+			*bytes += end - start;
+
+		for (k = s; k <= last; k++) {
+			// headers in between are skipped, not parsed
+			uint16_t off = (k / HIST_REC_SAMPLES) * HIST_REC_BYTES
+					+ (k % HIST_REC_SAMPLES) * 2 - s * 2;
+			acc += ((uint16_t)chunk[off] << 8) | chunk[off + 1];
+			if (++acc_n == group) {
+				out[o++] = (uint16_t)(acc / group);
+				acc = 0;
+				acc_n = 0;
+			}
+		}
+		from += cnt;
+		n -= cnt;
+	}
+	return 0;
+}
@@ -0,0 +1,57 @@
+/*****************************************************************************
+ *   Recorded history in EEPROM. Each sensor has an append-only ring of
+ *   records in its own region; a record is one trigger window of samples
+ *   with its sequence number and the time of its last sample. The newest
+ *   record is found from the sequence numbers when the log is opened, so
+ *   an append writes nothing but the record. A directory page at the start
+ *   of the EEPROM holds a layout word per sensor; a region whose word does
+ *   not match HIST_MAGIC is cleared on open.
+ *
+ *   The RAM index keeps the time of every record, so a view of the log can
+ *   be fetched with a few sequential reads of only the bytes it shows.
+ *
+ ******************************************************************************/
+#ifndef HISTORY_H_
+#define HISTORY_H_
+
+#include "lpc_types.h"
+
+#define HIST_EEPROM_SIZE 16384	// 24LC128 on the base board
+#define HIST_SENSORS 4
+#define HIST_DIR_BYTES 64		// one page, 4 bytes per sensor
+#define HIST_MAGIC 0x48530002	// "HS", layout version 2
+#define HIST_REC_SAMPLES 20
+#define HIST_HDR_BYTES 12		// seq, time_s, period_s, samples
+#define HIST_TIME_OFF 4
+#define HIST_REC_BYTES (HIST_HDR_BYTES + HIST_REC_SAMPLES * 2)
+#define HIST_REGION_BYTES ((HIST_EEPROM_SIZE - HIST_DIR_BYTES) / HIST_SENSORS)
+#define HIST_RECORDS (HIST_REGION_BYTES / HIST_REC_BYTES)	// 78
+#define HIST_REGION(i) (HIST_DIR_BYTES + (i) * HIST_REGION_BYTES)
+#define HIST_CHUNK_RECORDS 8	// largest single sequential read
+/* sequence numbers run modulo a whole number of laps, which keeps slot
+ * n % HIST_RECORDS across the wrap and the erased 0xFFFFFFFF invalid */
+#define HIST_SEQ_WRAP ((0xFFFFFFFFu / HIST_RECORDS) * HIST_RECORDS)
+
+typedef struct {
+	uint16_t base;			// region start in EEPROM
+	uint16_t dir;			// directory entry address
+	uint32_t total;			// records written modulo HIST_SEQ_WRAP, the next sequence number
+	uint8_t lapped;			// total has wrapped, the ring is full
+	uint32_t epoch;			// log time at boot, seconds
+	uint8_t built;			// time_s[] holds every record
+	uint32_t time_s[HIST_RECORDS];	// per slot, time of the last sample
+} hist_log_t;
+
+/* bytes written to EEPROM since boot */
+extern uint32_t hist_bytes_written;
+
+int hist_open(hist_log_t* log, uint16_t base, uint32_t now_s);
+int hist_append(hist_log_t* log, const uint16_t* samples, uint16_t period_s, uint32_t now_s);
+int hist_latest(hist_log_t* log, uint16_t* samples);
+int hist_build(hist_log_t* log, uint32_t* bytes);
+uint32_t hist_samples(const hist_log_t* log);
+uint32_t hist_time_at(const hist_log_t* log, uint32_t pos);
+int hist_fetch(hist_log_t* log, uint32_t from, uint16_t n, uint16_t group,
+		uint16_t* out, uint32_t* bytes);
+
+#endif /* HISTORY_H_ */
@@ -0,0 +1,29 @@
+/*****************************************************************************
+ *   Ownership of I2C2 between the main loop and the accelerometer sampling
+ *   interrupt. The main loop marks the bus busy around its own transfers;
+ *   the interrupt skips a sample rather than interleave with them. A read
+ *   the interrupt already started is waited for: it takes a few hundred
+ *   us, and the sampling interrupt aborts it if it never completes.
+ *
+ ******************************************************************************/
+#ifndef I2C_BUS_H_
+#define I2C_BUS_H_
+
+#include "lpc_types.h"
+
+extern volatile uint8_t i2c_bus_busy;
+extern volatile uint8_t i2c_bus_acc;	// accelerometer read in flight
+
+static inline void i2c_bus_lock(void)
+{
+	i2c_bus_busy = 1;
+	while (i2c_bus_acc)
+		;
+}
+
+static inline void i2c_bus_unlock(void)
+{
+	i2c_bus_busy = 0;
+}
+
+#endif /* I2C_BUS_H_ */
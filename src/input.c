@@ -0,0 +1,181 @@
+#include "lpc17xx_gpio.h"
+
+#include "joystick.h"
+#include "rotary.h"
+
+#include "input.h"
+#include "sections.h"
+#include "spsc.h"
+
+/*
+ * Pins, all active low:
+ * P0.17 - joystick center, P0.15 - down, P0.16 - right
+ * P2.3  - joystick up,     P2.4  - left
+ * P0.4  - SW3
+ * P0.24, P0.25 - rotary encoder A/B
+ */
+#define JOY_P0_MASK ((1<<17) | (1<<15) | (1<<16))
+#define JOY_P2_MASK ((1<<3) | (1<<4))
+#define SW3_MASK (1<<4)
+#define ROT_MASK ((1<<24) | (1<<25))
+
+#define NUM_KEYS 6
+
+static uint32_t (*getTicks)(void) = NULL;
+
+static input_event_t events[INPUT_QUEUE_LEN];
+static spsc_t queue = SPSC_INIT(events);	// filled by the interrupt only
+
+static uint32_t key_tick[NUM_KEYS];	// last edge of either direction
+static uint8_t key_down[NUM_KEYS];
+static uint8_t rot_state;
+static int8_t rot_steps;
+
+/* quadrature step for (previous state << 2 | new state), 0 for bounces */
+static const int8_t rot_table[16] = {
+		0, -1, 1, 0,
+		1, 0, 0, -1,
+		-1, 0, 0, 1,
+		0, 1, -1, 0
+};
+
+__RAMFUNC static void push(uint8_t src, uint8_t code, uint32_t tick)
+{
+	input_event_t ev;
+
+	ev.src = src;
+	ev.code = code;
+	ev.tick = tick;
+	spsc_put(&queue, &ev);
+}
+
+/* A press counts only if the key was released before and the pin then
+ * stayed high for INPUT_DEBOUNCE_MS: every rising edge restarts the
+ * window, so release bounce never reads as a new press. */
+__RAMFUNC static void key_edge(int key, int fall, uint8_t src, uint8_t code, uint32_t now)
+{
+	if (!fall) {
+		key_down[key] = 0;
+		key_tick[key] = now;
+		return;
+	}
+	if (key_down[key] || now - key_tick[key] < INPUT_DEBOUNCE_MS)
+		return;
+	key_down[key] = 1;
+	key_tick[key] = now;
+	push(src, code, now);
+}
+
+__RAMFUNC static void key_edges(int key, uint32_t fall, uint32_t rise, uint32_t high,
+		uint8_t src, uint8_t code, uint32_t now)
+{
+	// both edges since the last interrupt: the pin level tells which was last
+	if (fall && rise)
+		key_edge(key, !high, src, code, now);
+	else if (fall)
+		key_edge(key, 1, src, code, now);
+	else if (rise)
+		key_edge(key, 0, src, code, now);
+}
+
+__RAMFUNC static void rotary_edge(uint32_t now)
+{
+	uint8_t state = (GPIO_ReadValue(0) >> 24) & 0x03;
+
+	rot_steps += rot_table[(rot_state << 2) | state];
+	rot_state = state;
+
+	// one detent is a full cycle back to the resting state (both high)
+	if (state == 0x03) {
+		if (rot_steps >= 2)
+			push(INPUT_ROTARY, ROTARY_RIGHT, now);
+		else if (rot_steps <= -2)
+			push(INPUT_ROTARY, ROTARY_LEFT, now);
+		rot_steps = 0;
+	}
+}
+
+__RAMFUNC void EINT3_IRQHandler(void)
+{
+	uint32_t now = getTicks();
+	uint32_t p0 = LPC_GPIOINT->IO0IntStatF;
+	uint32_t p0r = LPC_GPIOINT->IO0IntStatR;
+	uint32_t p2 = LPC_GPIOINT->IO2IntStatF;
+	uint32_t p2r = LPC_GPIOINT->IO2IntStatR;
+	uint32_t v0 = GPIO_ReadValue(0);
+	uint32_t v2 = GPIO_ReadValue(2);
+
+	LPC_GPIOINT->IO0IntClr = p0 | p0r;
+	LPC_GPIOINT->IO2IntClr = p2 | p2r;
+
+	key_edges(0, p0 & (1<<17), p0r & (1<<17), v0 & (1<<17),
+			INPUT_JOY, JOYSTICK_CENTER, now);
+	key_edges(1, p0 & (1<<15), p0r & (1<<15), v0 & (1<<15),
+			INPUT_JOY, JOYSTICK_DOWN, now);
+	key_edges(2, p0 & (1<<16), p0r & (1<<16), v0 & (1<<16),
+			INPUT_JOY, JOYSTICK_RIGHT, now);
+	key_edges(3, p2 & (1<<3), p2r & (1<<3), v2 & (1<<3),
+			INPUT_JOY, JOYSTICK_UP, now);
+	key_edges(4, p2 & (1<<4), p2r & (1<<4), v2 & (1<<4),
+			INPUT_JOY, JOYSTICK_LEFT, now);
+	key_edges(5, p0 & SW3_MASK, p0r & SW3_MASK, v0 & SW3_MASK,
+			INPUT_SW3, 0, now);
+	if ((p0 | p0r) & ROT_MASK)
+		rotary_edge(now);
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Configure both edge interrupts for the joystick, SW3 and the rotary
+ *    encoder; key releases are needed for debouncing. joystick_init() and rotary_init() must
+ *    have been called.
+ *
+ * Params:
+ *   [in] getMsTicks - callback returning the ms tick used for debouncing
+ *
+ *****************************************************************************/
+void input_init(uint32_t (*getMsTicks)(void))
+{
+	getTicks = getMsTicks;
+	spsc_reset(&queue);
+	rot_state = (GPIO_ReadValue(0) >> 24) & 0x03;
+
+	GPIO_SetDir(0, SW3_MASK, 0);
+
+	// GPIO_IntCmd overwrites the enable register, so set each edge once
+	GPIO_IntCmd(0, JOY_P0_MASK | SW3_MASK | ROT_MASK, 1);
+	GPIO_IntCmd(0, JOY_P0_MASK | SW3_MASK | ROT_MASK, 0);
+	GPIO_IntCmd(2, JOY_P2_MASK, 1);
+	GPIO_IntCmd(2, JOY_P2_MASK, 0);
+
+	NVIC_EnableIRQ(EINT3_IRQn);
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Take the oldest queued input event
+ *
+ * Params:
+ *   [out] ev - the event
+ *
+ * Returns:
+ *   1 if an event was returned, 0 if the queue is empty
+ *
+ *****************************************************************************/
+int input_get(input_event_t* ev)
+{
+	return spsc_get(&queue, ev);
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Number of events lost because the queue was full
+ *
+ *****************************************************************************/
+uint32_t input_dropped(void)
+{
+	return queue.dropped;
+}
@@ -0,0 +1,30 @@
+/*****************************************************************************
+ *   Interrupt driven joystick, rotary encoder and SW3 input. Edges are
+ *   debounced in the GPIO interrupt and queued for the main loop.
+ *
+ ******************************************************************************/
+#ifndef INPUT_H_
+#define INPUT_H_
+
+#include "lpc_types.h"
+
+#define INPUT_QUEUE_LEN 16	// must be a power of two
+#define INPUT_DEBOUNCE_MS 30
+
+typedef enum {
+	INPUT_JOY = 0,			// code is one of JOYSTICK_*
+	INPUT_SW3,
+	INPUT_ROTARY			// code is ROTARY_RIGHT or ROTARY_LEFT
+} input_src_t;
+
+typedef struct {
+	uint8_t src;
+	uint8_t code;
+	uint32_t tick;			// ms tick at which the edge was accepted
+} input_event_t;
+
+void input_init(uint32_t (*getMsTicks)(void));
+int input_get(input_event_t* ev);
+uint32_t input_dropped(void);
+
+#endif /* INPUT_H_ */
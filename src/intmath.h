@@ -0,0 +1,27 @@
+#ifndef INTMATH_H_
+#define INTMATH_H_
+
+#include "lpc_types.h"
+
+/* floor(sqrt(v)), bit by bit; the M3 has no FPU */
+static inline uint32_t isqrt32(uint32_t v)
+{
+	uint32_t res = 0;
+	uint32_t bit = 1UL << 30;
+
+	while (bit > v)
+		bit >>= 2;
+	while (bit != 0) {
+		if (v >= res + bit) {
+			v -= res + bit;
+			res = (res >> 1) + bit;
+		}
+		else {
+			res >>= 1;
+		}
+		bit >>= 2;
+	}
+	return res;
+}
+
+#endif /* INTMATH_H_ */
@@ -0,0 +1,107 @@
+#include "pca9532.h"
+
+#include "ledbar.h"
+#include "i2c_bus.h"
+
+static uint8_t shown_level = 0xFF;	// nothing written yet
+static uint8_t shown_overload;
+static uint32_t writes;
+
+/******************************************************************************
+ *
+ * Description:
+ *    Set up blink 0 for the overload indication and clear the bar.
+ *    pca9532_init() must have been called.
+ *
+ *****************************************************************************/
+void ledbar_init(void)
+{
+	i2c_bus_lock();
+	pca9532_setBlink0Period(LEDBAR_BLINK_PSC);
+	pca9532_setBlink0Duty(50);
+	i2c_bus_unlock();
+	shown_level = 0xFF;
+	ledbar_show(0, 0);
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Map a value onto the bar
+ *
+ * Params:
+ *   [in] value - value to show
+ *   [in] min - value of an empty bar
+ *   [in] max - value of a full bar
+ *
+ * Returns:
+ *   Number of LEDs to light, 0 to LEDBAR_LEDS
+ *
+ *****************************************************************************/
+uint8_t ledbar_level(int32_t value, int32_t min, int32_t max)
+{
+	if (value <= min)
+		return 0;
+	if (value >= max)
+		return LEDBAR_LEDS;
+	// round to the nearest LED
+	return (uint8_t)(((value - min) * LEDBAR_LEDS + (max - min) / 2) / (max - min));
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Show a level, blinking the whole bar on overload. Does nothing if
+ *    that is what the LEDs already show.
+ *
+ * Params:
+ *   [in] level - LEDs to light from LED 0 up, 0 to LEDBAR_LEDS
+ *   [in] overload - non zero to blink all LEDs instead
+ *
+ * Returns:
+ *   1 if the LEDs were written, 0 if unchanged
+ *
+ *****************************************************************************/
+int ledbar_show(uint8_t level, uint8_t overload)
+{
+	uint16_t on;
+
+	overload = overload ? 1 : 0;
+	if (overload) {
+		if (shown_overload)
+			return 0;
+	}
+	else if (!shown_overload && level == shown_level) {
+		return 0;
+	}
+
+	i2c_bus_lock();
+	if (overload) {
+		pca9532_setBlink0Leds(0xFFFF);
+	}
+	else {
+		// setLeds() only stops blinking on LEDs in the off mask, so leaving
+		// overload takes every LED out of blink 0 first
+		if (shown_overload)
+			pca9532_setLeds(0, 0xFFFF);
+		on = (level >= LEDBAR_LEDS) ? 0xFFFF : (uint16_t)((1 << level) - 1);
+		pca9532_setLeds(on, (uint16_t)~on);
+	}
+	i2c_bus_unlock();
+
+	shown_level = level;
+	shown_overload = overload;
+	writes++;
+	return 1;
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Number of I2C updates of the bar since boot
+ *
+ *****************************************************************************/
+uint32_t ledbar_writes(void)
+{
+	return writes;
+}
@@ -0,0 +1,21 @@
+/*****************************************************************************
+ *   The 16 PCA9532 LEDs as a level meter. The bar is only rewritten when
+ *   the level changes, and a change costs one auto-incremented write of
+ *   the four LED selector registers.
+ *
+ ******************************************************************************/
+#ifndef LEDBAR_H_
+#define LEDBAR_H_
+
+#include "lpc_types.h"
+
+#define LEDBAR_LEDS 16
+#define LEDBAR_MS 50		// meter refresh, 20 Hz
+#define LEDBAR_BLINK_PSC 37	// blink 0 period (PSC + 1) / 152 s, ~4 Hz
+
+void ledbar_init(void);
+uint8_t ledbar_level(int32_t value, int32_t min, int32_t max);
+int ledbar_show(uint8_t level, uint8_t overload);
+uint32_t ledbar_writes(void);
+
+#endif /* LEDBAR_H_ */
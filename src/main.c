@@ -7,6 +7,8 @@
  *
  ******************************************************************************/
 
+#include <string.h>
+
 #include "lpc17xx_pinsel.h"
 #include "lpc17xx_gpio.h"
 #include "lpc17xx_i2c.h"
@@ -23,29 +25,96 @@
 #include "pca9532.h"
 #include "eeprom.h"
 
-#define BUFF_LEN 20
-#define TEMP_ADD 0
-#define LIGHT_ADD 321
-#define POTEN_ADD 641
+#include "oled_graphing.h"
+#include "sections.h"
+#include "profile.h"
+#include "trigger.h"
+#include "input.h"
+#include "scope.h"
+#include "fft.h"
+#include "vibration.h"
+#include "i2c_bus.h"
+#include "sensor.h"
+#include "histo.h"
+#include "serial.h"
+#include "ledbar.h"
+#include "history.h"
+#include "memstat.h"
+#include "fault.h"
+#include "trace.h"
+#include "numfmt.h"
+
+#define BUFF_LEN HIST_REC_SAMPLES
+#define SAMPLE_MS 1000
+#define NUM_MODES 6
+#define MODE_SCOPE 3
+#define MODE_SPECTRUM 4
+#define MODE_DIAG 5
+#define DIAG_MS 500
+#define SPECTRUM_BARS 64
+#define TEMP_ADD HIST_REGION(0)
+#define LIGHT_ADD HIST_REGION(1)
+#define POTEN_ADD HIST_REGION(2)
+#define VIB_ADD HIST_REGION(3)
+#define REPLAY_ZOOM_MAX 6		// BUFF_LEN << 6 samples per view
 
 #define NOTE_PIN_HIGH() GPIO_SetValue(0, 1<<26);
 #define NOTE_PIN_LOW()  GPIO_ClearValue(0, 1<<26);
 
 
 static uint32_t msTicks = 0;
-static uint8_t buf[10];
-static uint16_t data_temp[20];
-static uint16_t data_light[20];
-static uint16_t data_poten[20];
+static uint8_t buf[FMT_BUF];
+static uint16_t data_temp[BUFF_LEN] __BSS_AHB;
+static uint16_t data_light[BUFF_LEN] __BSS_AHB;
+static uint16_t data_poten[BUFF_LEN] __BSS_AHB;
+static uint16_t data_vib[BUFF_LEN] __BSS_AHB;
+static vib_metrics_t vib;
 static uint32_t startTime;
 static int data_type;
+static const sensor_t* sensor;
 static int mode;
 static int time = 10;
 static int count;
 static uint8_t ch7seg = '0';
 static int draw_graph;
+static numfield_t f_value;
+static numfield_t f_peak;
+static numfield_t f_crest;
+static numfield_t f_saved;
+static numfield_t f_skipped;
 static int draw_recorded;
+static hist_log_t logs[HIST_SENSORS] __BSS_AHB;
+static uint8_t replay_zoom;
+static uint32_t replay_pos;
+static uint16_t replay_pts[SCOPE_WIDTH];
+static uint16_t replay_n;		// points in replay_pts, 0 without records
+/* EEPROM bytes read by the last view change */
+static uint32_t replay_bytes;
 static int draw_record;
+static uint32_t sampleTime;
+/* sample lateness beyond the nominal period and input edge to display */
+static histo_t h_sample;
+static histo_t h_input;
+static uint32_t input_tick;
+static uint8_t input_pending;
+static uint8_t note_pending;	// played once the input is on screen
+static uint32_t diagTime;
+static uint32_t ledTime;
+/* largest AD0.0 code of the last scope or spectrum capture */
+static uint16_t adc_peak;
+
+static trig_state_t trig;
+static uint16_t scope_pts[SCOPE_WIDTH];
+
+static const uint32_t spectrum_rates[] = { 200000, 50000, 10000, 2000 };
+static uint8_t spectrum_rate;
+static uint8_t spectrum_log2n = 7;
+static int16_t fft_re[FFT_MAX_N] __BSS_AHB;
+static int16_t fft_im[FFT_MAX_N] __BSS_AHB;
+static uint16_t fft_mag[FFT_MAX_N / 2] __BSS_AHB;
+static uint8_t spectrum_h[SPECTRUM_BARS];
+/* cycles of the last FFT (window + transform + magnitude) per size */
+static uint32_t fft_cycles[FFT_LOG2_MAX - FFT_LOG2_MIN + 1];
 
 static uint32_t notes[] = {
         2272, // A - 440 Hz
@@ -64,58 +133,6 @@ static uint32_t notes[] = {
         1275, // g - 784 Hz
 };
 
-static void intToString(int value, uint8_t* pBuf, uint32_t len, uint32_t base)
-{
-    static const char* pAscii = "0123456789abcdefghijklmnopqrstuvwxyz";
-    int pos = 0;
-    int tmpValue = value;
-
-    // the buffer must not be null and at least have a length of 2 to handle one
-    // digit and null-terminator
-    if (pBuf == NULL || len < 2)
-    {
-        return;
-    }
-
-    // a valid base cannot be less than 2 or larger than 36
-    // a base value of 2 means binary representation. A value of 1 would mean only zeros
-    // a base larger than 36 can only be used if a larger alphabet were used.
-    if (base < 2 || base > 36)
-    {
-        return;
-    }
-
-    // negative value
-    if (value < 0)
-    {
-        tmpValue = -tmpValue;
-        value    = -value;
-        pBuf[pos++] = '-';
-    }
-
-    // calculate the required length of the buffer
-    do {
-        pos++;
-        tmpValue /= base;
-    } while(tmpValue > 0);
-
-
-    if (pos > len)
-    {
-        // the len parameter is invalid.
-        return;
-    }
-
-    pBuf[pos] = '\0';
-
-    do {
-        pBuf[--pos] = pAscii[value % base];
-        value /= base;
-    } while(value > 0);
-
-    return;
-}
-
 static void init_ssp(void)
 {
 	SSP_CFG_Type SSP_ConfigStruct;
@@ -198,7 +215,7 @@ static void init_adc(void)
 }
 
 
-void SysTick_Handler(void) {
+__RAMFUNC void SysTick_Handler(void) {
     msTicks++;
 }
 
@@ -209,12 +226,7 @@ static uint32_t getTicks(void)
 
 static void change7Seg(int value)
 {
-    if (value == 0)
-    	ch7seg = '1';
-    else if (value == 1)
-    	ch7seg = '2';
-    else
-    	ch7seg = '3';
+    ch7seg = '1' + value;
     led7seg_setChar(ch7seg, FALSE);
 }
 
@@ -262,64 +274,585 @@ void fill_buffer(int32_t new_data, uint16_t* data){
 }
 
 void clear_buffer(uint16_t* data){
-	for(int i=0; i<(BUFF_LEN - 1); i++){
+	for(int i=0; i<BUFF_LEN; i++){
 		data[i] = 0;
 	}
 }
 
-int write_to_eeprom(uint16_t *data, uint16_t offset){
-	int16_t len = 0;
-	for(int i=0; i<(BUFF_LEN - 1); i++){
-		uint8_t temp[2];
-		// last 8 bits
-		temp[1] = (uint8_t)data[i];
-		// first 8 bits
-		temp[0] = (uint8_t)(data[i] >> 8);
-		len = eeprom_write(temp, (uint16_t)(offset + i*2), (uint16_t)2);
-		if(len != 2)
-			return 1;
+static void choose_interval(void)
+{
+	input_event_t ev;
+
+	time = 10;
+	oled_clearScreen(OLED_COLOR_WHITE);
+	oled_putString(1, 1, "Choose t (sec):", OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+	numfield_init(&f_value, 35, 15, 2, OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+	numfield_show(&f_value, buf, fmt_i32(time, buf));
+	while(1){
+		if (!input_get(&ev)) {
+			// sleep until the next tick or input edge
+			__WFI();
+			continue;
+		}
+		// traced like the main loop's input, so a replay can leave the dialog
+		trace_put(ev.tick, TRACE_INPUT, ev.src, ev.code, 0);
+		if (ev.src == INPUT_JOY && ev.code == JOYSTICK_CENTER)
+			break;
+		if (ev.src != INPUT_ROTARY)
+			continue;
+
+		if (ev.code == ROTARY_RIGHT) {
+			time++;
+			if (time > 60)
+				time = 60;
+		}
+		else {
+			time--;
+			if (time < 10)
+				time = 10;
+		}
+		numfield_show(&f_value, buf, fmt_i32(time, buf));
 	}
-	return 0;
 }
 
-int read_from_eeprom(uint16_t *data, uint16_t offset){
-	int16_t len = 0;
-	for(int i=0; i<(BUFF_LEN - 1); i++){
-		uint8_t temp[2];
-		len = eeprom_read(temp, (uint16_t)(offset + i*2), (uint16_t)2);
-		if(len != 2)
-			return 1;
-		// first 8 bits
-		data[i] = (uint16_t)(temp[0] << 8);
-		// last 8 bits
-		data[i] = data[i] + (uint16_t)temp[1];
+/* rms, peak and crest factor side by side */
+static void reset_vib(const sensor_t* s)
+{
+	numfield_init(&f_value, s->value_x, 1, 4, OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+	numfield_init(&f_peak, 36, 1, 4, OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+	numfield_init(&f_crest, 64, 1, 5, OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+}
+
+static void show_vib(int32_t value)
+{
+	const vib_metrics_t* m = &vib;
+
+	numfield_show(&f_value, buf, fmt_i32(value, buf));
+	numfield_show(&f_peak, buf, fmt_u32(m->peak_mg, buf));
+	// crest factor with one decimal
+	numfield_show(&f_crest, buf, fmt_tenths(m->crest_x10, buf));
+}
+
+static void scope_status(void)
+{
+	oled_fillRect(1, 1, 95, 9, OLED_COLOR_WHITE);
+	oled_putString(1, 1, scope_cfg.slope == SCOPE_RISING ? "/" : "\\",
+			OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+	fmt_i32(scope_cfg.level, buf);
+	oled_putString(10, 1, buf, OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+	// microseconds per point
+	fmt_u32(scope_decimation(scope_cfg.timebase) * (1000000 / SCOPE_RATE), buf);
+	oled_putString(45, 1, buf, OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+	oled_putString(70, 1, "us", OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+}
+
+static void scope_control(const input_event_t* ev)
+{
+	if (ev->src == INPUT_ROTARY) {
+		// trigger level, 64 codes per detent
+		if (ev->code == ROTARY_RIGHT && scope_cfg.level <= 4095 - 64)
+			scope_cfg.level += 64;
+		else if (ev->code == ROTARY_LEFT && scope_cfg.level >= 64)
+			scope_cfg.level -= 64;
+	}
+	else if (ev->code == JOYSTICK_LEFT) {
+		if (scope_cfg.timebase + 1 < scope_timebases())
+			scope_cfg.timebase++;
+	}
+	else if (ev->code == JOYSTICK_RIGHT) {
+		if (scope_cfg.timebase > 0)
+			scope_cfg.timebase--;
+	}
+	else if (ev->code == JOYSTICK_UP || ev->code == JOYSTICK_DOWN) {
+		scope_cfg.slope = (scope_cfg.slope == SCOPE_RISING) ? SCOPE_FALLING : SCOPE_RISING;
+	}
+	else {
+		return;
+	}
+	scope_status();
+}
+
+static void spectrum_status(void)
+{
+	oled_fillRect(1, 1, 95, 9, OLED_COLOR_WHITE);
+	oled_putString(1, 1, "N", OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+	fmt_u32(1 << spectrum_log2n, buf);
+	oled_putString(8, 1, buf, OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+	// span shown is half the sample rate
+	fmt_u32(spectrum_rates[spectrum_rate] / 2, buf);
+	oled_putString(40, 1, buf, OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+	oled_putString(80, 1, "Hz", OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+}
+
+static void spectrum_control(const input_event_t* ev)
+{
+	if (ev->src == INPUT_ROTARY) {
+		if (ev->code == ROTARY_RIGHT && spectrum_log2n < FFT_LOG2_MAX)
+			spectrum_log2n++;
+		else if (ev->code == ROTARY_LEFT && spectrum_log2n > FFT_LOG2_MIN)
+			spectrum_log2n--;
+	}
+	else if (ev->code == JOYSTICK_LEFT) {
+		if (spectrum_rate + 1 < sizeof(spectrum_rates) / sizeof(spectrum_rates[0]))
+			spectrum_rate++;
+		scope_set_rate(spectrum_rates[spectrum_rate]);
+	}
+	else if (ev->code == JOYSTICK_RIGHT) {
+		if (spectrum_rate > 0)
+			spectrum_rate--;
+		scope_set_rate(spectrum_rates[spectrum_rate]);
+	}
+	else {
+		return;
+	}
+	spectrum_status();
+}
+
+static void spectrum_update(const uint32_t* block)
+{
+	int n = 1 << spectrum_log2n;
+	int bars = (n / 2 < SPECTRUM_BARS) ? n / 2 : SPECTRUM_BARS;
+	int per_bar = (n / 2) / bars;
+	uint32_t cyc = prof_begin();
+
+	adc_peak = 0;
+	for (int i = 0; i < n; i++) {
+		uint16_t v = SCOPE_SAMPLE(block[i]);
+		if (v > adc_peak)
+			adc_peak = v;
+		// 12 bit unsigned to Q15 around mid scale
+		fft_re[i] = (int16_t)(((int32_t)v - 2048) << 3);
+		fft_im[i] = 0;
+	}
+	fft_window(fft_re, spectrum_log2n);
+	fft_q15(fft_re, fft_im, spectrum_log2n);
+	fft_magnitude(fft_re, fft_im, fft_mag, n / 2);
+	fft_cycles[spectrum_log2n - FFT_LOG2_MIN] = DWT_CYCCNT - cyc;
+
+	for (int b = 0; b < bars; b++) {
+		uint16_t peak = 0;
+		for (int k = 0; k < per_bar; k++)
+			if (fft_mag[b * per_bar + k] > peak)
+				peak = fft_mag[b * per_bar + k];
+		// 13 bits of magnitude in quarter steps onto 40 pixels
+		spectrum_h[b] = (uint8_t)((fft_log2_q2(peak) * 40) / 52);
 	}
+	draw_bars(spectrum_h, (uint8_t)bars, (uint8_t)(SPECTRUM_BARS / bars));
+}
+
+/* value from sensor_fixed(), with the sensor's decimals */
+static void show_value(const sensor_t* s, int32_t fixed)
+{
+	if (s->decimals > 0)
+		numfield_show(&f_value, buf, fmt_tenths(fixed, buf));
+	else
+		numfield_show(&f_value, buf, fmt_i32(fixed, buf));
+}
+
+/* title and value fields of the live graph, after the outline cleared them */
+static void show_reset(const sensor_t* s)
+{
+	oled_fillRect(0, 0, 95, 8, OLED_COLOR_WHITE);
+	oled_putString(1, 1, (uint8_t*)s->name, OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+	if (s->reset != NULL)
+		s->reset(s);
+	else
+		numfield_init(&f_value, s->value_x, 1, (OLED_DISPLAY_WIDTH - s->value_x) / 6,
+				OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+}
+
+/* status line values of a new sample, raw as read */
+static void show_sample(const sensor_t* s, int32_t raw)
+{
+	if (s->show != NULL)
+		s->show(sensor_scale(s, raw));
+	else
+		show_value(s, sensor_fixed(s, raw));
+}
+
+static int32_t read_light(void)
+{
+	int32_t lux;
+
+	i2c_bus_lock();
+	lux = light_read();
+	i2c_bus_unlock();
+	return lux;
+}
+
+static void start_poten(void)
+{
+	ADC_StartCmd(LPC_ADC,ADC_START_NOW);
+}
+
+static int32_t read_poten(void)
+{
+	//Wait conversion complete
+	while (!(ADC_ChannelGetStatus(LPC_ADC,ADC_CHANNEL_0,ADC_DATA_DONE)));
+	return ADC_ChannelGetData(LPC_ADC,ADC_CHANNEL_0);
+}
+
+static int32_t read_vib(void)
+{
+	// vib_get() reduces the queued batches once per loop
+	return vib.rms_mg;
+}
+
+/* Sensors selectable with the joystick, indexed by data_type. Trigger
+ * pre + 1 + post == BUFF_LEN so an event window is exactly the history
+ * buffer written to EEPROM. */
+static const sensor_t sensors[] = {
+	{
+		.name = "Temp:", .label = "Temperature", .recorded = "Recorded temp:",
+		.read = &temp_read,
+		.scale = 10, .decimals = 1,				// read in tenths of a degree
+		.min = 25, .max = 35, .delimiter = 3,
+		.value_x = 60, .label_x = 15,
+		.joy = JOYSTICK_LEFT, .note = 'C', .period_ms = SAMPLE_MS,
+		.meter_live = 0,						// temp_read() waits for a conversion
+		.eeprom_addr = TEMP_ADD,
+		.trig = { .kind = TRIG_LEVEL_ABOVE, .level = 30, .deadband = 1,
+				  .pre = 14, .post = 5 },		// temperature >= 30 C
+		.hist = data_temp,
+	},
+	{
+		.name = "Light:", .label = "Light", .recorded = "Recorded light:",
+		.read = &read_light,
+		.scale = 1,								// lux
+		.min = 0, .max = 500, .delimiter = 5,
+		.value_x = 60, .label_x = 33,
+		.joy = JOYSTICK_UP, .note = 'D', .period_ms = SAMPLE_MS,
+		.meter_live = 1,
+		.eeprom_addr = LIGHT_ADD,
+		.trig = { .kind = TRIG_RATE, .level = 100, .deadband = 20,
+				  .pre = 14, .post = 5 },		// light jumps by 100 lux
+		.hist = data_light,
+	},
+	{
+		.name = "Poten:", .label = "Potentiometer", .recorded = "Recorded poten:",
+		.start = &start_poten, .read = &read_poten,
+		.scale = 1,								// 12 bit ADC code
+		.min = 99, .max = 4100, .delimiter = 4,
+		.value_x = 60, .label_x = 10,
+		.joy = JOYSTICK_RIGHT, .note = 'E', .period_ms = SAMPLE_MS,
+		.meter_live = 1,
+		.eeprom_addr = POTEN_ADD,
+		.trig = { .kind = TRIG_RATE, .level = 200, .deadband = 50,
+				  .pre = 14, .post = 5 },		// trimpot moved by 200
+		.hist = data_poten,
+	},
+	{
+		.name = "V", .label = "Vibration", .recorded = "Recorded vib:",
+		.read = &read_vib, .reset = &reset_vib, .show = &show_vib,
+		.scale = 1,								// mg RMS
+		.min = 0, .max = 500, .delimiter = 5,
+		.value_x = 8, .label_x = 21,
+		.joy = JOYSTICK_DOWN, .note = 'G', .period_ms = SAMPLE_MS,
+		.meter_live = 1,
+		.eeprom_addr = VIB_ADD,
+		.trig = { .kind = TRIG_LEVEL_ABOVE, .level = 200, .deadband = 20,
+				  .pre = 14, .post = 5 },		// vibration >= 200 mg RMS
+		.hist = data_vib,
+	},
+};
+#define NUM_SENSORS (sizeof(sensors) / sizeof(sensors[0]))
+
+/* logs[] and the EEPROM regions are sized by HIST_SENSORS: one per sensor */
+typedef char hist_sensors_check[(NUM_SENSORS == HIST_SENSORS) ? 1 : -1];
+
+/* replay view on the newest records, one sample per point */
+static void replay_reset(void)
+{
+	replay_zoom = 0;
+	replay_pos = 0xFFFFFFFF;
+}
+
+static void replay_control(const input_event_t* ev)
+{
+	uint32_t span = BUFF_LEN << replay_zoom;
+	uint32_t total = hist_samples(&logs[data_type]);
+
+	// resolve "newest" before moving from it
+	if (total < span)
+		replay_pos = 0;
+	else if (replay_pos > total - span)
+		replay_pos = total - span;
+
+	if (ev->src == INPUT_ROTARY) {
+		// zoom about the middle of the view
+		if (ev->code == ROTARY_RIGHT && replay_zoom > 0) {
+			replay_zoom--;
+			replay_pos += span / 4;
+		}
+		else if (ev->code == ROTARY_LEFT && replay_zoom < REPLAY_ZOOM_MAX) {
+			replay_zoom++;
+			replay_pos = (replay_pos > span / 2) ? replay_pos - span / 2 : 0;
+		}
+		else {
+			return;
+		}
+	}
+	else if (ev->code == JOYSTICK_LEFT) {
+		replay_pos = (replay_pos > span / 2) ? replay_pos - span / 2 : 0;
+	}
+	else if (ev->code == JOYSTICK_RIGHT) {
+		replay_pos += span / 2;
+	}
+	else if (ev->code == JOYSTICK_CENTER) {
+		replay_pos = 0xFFFFFFFF;
+	}
+	else {
+		// up / down step through the sensors
+		if (ev->code == JOYSTICK_UP)
+			data_type = (data_type + NUM_SENSORS - 1) % NUM_SENSORS;
+		else
+			data_type = (data_type + 1) % NUM_SENSORS;
+		sensor = &sensors[data_type];
+		note_pending = sensor->note;
+		replay_reset();
+		draw_graph = 1;
+		draw_record = 1;
+	}
+	draw_recorded = 1;
+}
+
+static int replay_draw(void)
+{
+	hist_log_t* log = &logs[data_type];
+	uint32_t total, span;
+	uint16_t points;
+
+	replay_bytes = 0;
+	replay_n = 0;
+	if (!log->built && hist_build(log, &replay_bytes) != 0)
+		return 1;
+
+	draw_graph_outline(sensor->delimiter, OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+	total = hist_samples(log);
+	if (total == 0) {
+		oled_putString(1, 1, (uint8_t*)sensor->recorded, OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+		oled_putString(20, 30, "No records", OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+		return 0;
+	}
+
+	// whole records in the view, at most SCOPE_WIDTH points
+	while (replay_zoom > 0 && (uint32_t)(BUFF_LEN << replay_zoom) > total)
+		replay_zoom--;
+	span = BUFF_LEN << replay_zoom;
+	if (replay_pos > total - span)
+		replay_pos = total - span;
+	points = (span < SCOPE_WIDTH) ? span : SCOPE_WIDTH;
+	if (hist_fetch(log, replay_pos, span, span / points, replay_pts, &replay_bytes) != 0)
+		return 1;
+	replay_n = points;
+
+	// sensor, time of the first record shown and bytes this view cost
+	buf[0] = sensor->label[0];
+	buf[1] = '\0';
+	oled_putString(1, 1, buf, OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+	fmt_u32(hist_time_at(log, replay_pos), buf);
+	oled_putString(10, 1, buf, OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+	oled_putString(10 + 6 * strlen((char*)buf), 1, "s", OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+	fmt_u32(replay_bytes, buf);
+	oled_putString(60, 1, buf, OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+	oled_putString(60 + 6 * strlen((char*)buf), 1, "B", OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+
+	draw_data(sensor->min, sensor->max, replay_pts, points);
 	return 0;
 }
 
+/* a right aligned number in a field cleared with the screen, '#' if it
+ * does not fit */
+static void diag_num(uint8_t x, uint8_t y, uint8_t cells, uint32_t value)
+{
+	numfield_t f;
+
+	numfield_init(&f, x, y, cells, OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+	numfield_show(&f, buf, fmt_u32(value, buf));
+}
+
+/* tag and count, then p50, p99 and max under the header */
+static void diag_line(uint8_t y, const char* tag, const histo_t* h)
+{
+	oled_putString(1, y, (uint8_t*)tag, OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+	diag_num(55, y, 6, h->count);
+	diag_num(1, y + 9, 4, histo_percentile(h, 50));
+	diag_num(31, y + 9, 4, histo_percentile(h, 99));
+	diag_num(61, y + 9, 4, h->max);
+}
+
+/* oled_putChar() draws nothing from x 88 or y 56 on, so every line starts
+ * above y 56 and ends before x 88 */
+static void diag_draw(void)
+{
+	oled_clearScreen(OLED_COLOR_WHITE);
+	oled_putString(1, 1, " p50  p99  max", OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+	if (trace_enabled())
+		oled_putString(85, 1, "T", OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+	diag_line(10, "Sample ms", &h_sample);
+	diag_line(28, "Input ms", &h_input);
+	// deepest stack use and bytes left to it
+	mem_update();
+	oled_putString(1, 46, "stk", OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+	diag_num(25, 46, 5, mem[MEM_LOC].peak);
+	diag_num(61, 46, 5, mem[MEM_LOC].stack);
+	// first frame later than the boot target
+	if (boot_ms(BOOT_FIRST_FRAME) > BOOT_TARGET_MS)
+		oled_putString(1, 55, "B", OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+	// a fault recorded before the last reset
+	if (fault_valid()) {
+		buf[0] = 'F';
+		buf[1] = (uint8_t)('0' + fault_record.type);
+		buf[2] = '\0';
+		oled_putString(13, 55, buf, OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+	}
+}
+
+static void diag_field(uint32_t value, uint32_t base)
+{
+	static const char* pHex = "0123456789abcdef";
+	int i;
+
+	serial_puts(",");
+	if (base == 16) {
+		// all eight digits
+		for (i = 0; i < 8; i++)
+			buf[i] = pHex[(value >> (28 - 4 * i)) & 0x0F];
+		buf[8] = '\0';
+	}
+	else {
+		fmt_u32(value, buf);
+	}
+	serial_puts((char*)buf);
+}
+
+/* boot,<ms to each boot step>,<first frame target>
+ * mem,<region>,<size>,<static>,<stack>,<stack peak>
+ * fault,<type>,<pc>,<lr>,<psr>,<cfsr>,<hfsr>,<mmfar>,<bfar> (hex) */
+static void diag_export_mem(void)
+{
+	int i;
+
+	serial_puts("boot");
+	for (i = 0; i < BOOT_NUM; i++)
+		diag_field(boot_ms((boot_step_t)i), 10);
+	diag_field(BOOT_TARGET_MS, 10);
+	serial_puts("\r\n");
+
+	mem_update();
+	for (i = 0; i < MEM_NUM; i++) {
+		serial_puts("mem,");
+		serial_puts(mem[i].name);
+		diag_field(mem[i].size, 10);
+		diag_field(mem[i].statics, 10);
+		diag_field(mem[i].stack, 10);
+		diag_field(mem[i].peak, 10);
+		serial_puts("\r\n");
+	}
+	if (fault_valid()) {
+		serial_puts("fault");
+		diag_field(fault_record.type, 10);
+		diag_field(fault_record.pc, 16);
+		diag_field(fault_record.lr, 16);
+		diag_field(fault_record.psr, 16);
+		diag_field(fault_record.cfsr, 16);
+		diag_field(fault_record.hfsr, 16);
+		diag_field(fault_record.mmfar, 16);
+		diag_field(fault_record.bfar, 16);
+		serial_puts("\r\n");
+	}
+}
+
+/* one CSV line per histogram:
+ * hist,<name>,<width>,<count>,<max>,<bucket 0>..<bucket 15>,<over> */
+static void diag_export(const histo_t* h)
+{
+	int i;
+
+	serial_puts("hist,");
+	serial_puts(h->name);
+	serial_puts(",");
+	fmt_u32(h->width, buf);
+	serial_puts((char*)buf);
+	serial_puts(",");
+	fmt_u32(h->count, buf);
+	serial_puts((char*)buf);
+	serial_puts(",");
+	fmt_u32(h->max, buf);
+	serial_puts((char*)buf);
+	for (i = 0; i < HISTO_BUCKETS; i++) {
+		serial_puts(",");
+		fmt_u32(h->bucket[i], buf);
+		serial_puts((char*)buf);
+	}
+	serial_puts(",");
+	fmt_u32(h->over, buf);
+	serial_puts((char*)buf);
+	serial_puts("\r\n");
+}
 
 int main (void) {
-    uint8_t joy = 0;
+    input_event_t ev;
+
+    boot_mark(BOOT_CLOCK);
+    prof_init();
+    fault_init();
+
+    int32_t value = 0;
+    int32_t raw = 0;
+    int sel = 0;
+
+    int result = 0;
+    uint32_t cyc = 0;
+    uint32_t loop_cyc = 0;
+    int traced_mode = -1;
+    int traced_type = -1;
+
+    if (SysTick_Config(SystemCoreClock / 1000)) {
+    	while (1);  // Capture error
+    }
 
     init_i2c();
     init_ssp();
-    init_adc();
+    boot_mark(BOOT_BUS);
+
+    // start the first light conversion now so it settles during OLED setup
+    light_init();
+    light_enable();
+    light_setRange(LIGHT_RANGE_4000);
+    boot_mark(BOOT_LIGHT);
 
     oled_init();
+    boot_mark(BOOT_OLED);
+
+    // show the last recorded graph before anything else is initialized;
+    // mode 0 then keeps appending live samples to it
+    sensor = &sensors[data_type];
+    eeprom_init();
+    if (hist_open(&logs[data_type], sensor->eeprom_addr, 0) != 0)
+    	return 1;
+    if (hist_latest(&logs[data_type], sensor->hist) != 0)
+    	clear_buffer(sensor->hist);
+    draw_graph_outline(sensor->delimiter, OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+    oled_putString(1, 1, (uint8_t*)sensor->recorded, OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+    draw_data(sensor->min, sensor->max, sensor->hist, BUFF_LEN);
+    boot_mark(BOOT_FIRST_FRAME);
+
+    // the other logs are not needed for the first frame; opening a blank
+    // region writes its directory entry
+    for (sel = 0; sel < (int)NUM_SENSORS; sel++) {
+    	if (sel != data_type && hist_open(&logs[sel], sensors[sel].eeprom_addr, getTicks() / 1000) != 0)
+    		return 1;
+    }
+
+    init_adc();
     temp_init(&getTicks);
     joystick_init();
     rotary_init();
     led7seg_init();
-    light_init();
     pca9532_init();
-    eeprom_init();
-
-	int32_t light = 0;
-    int32_t t = 0;
-    int32_t potenc = 0;
-
-    uint8_t btn_1 = 0;
-    int result = 0;
+    vib_init();
+    ledbar_init();
 
     /* ---- Speaker ------> */
 
@@ -335,241 +868,274 @@ int main (void) {
 	GPIO_ClearValue(0, 1<<28); //LM4811-up/dn
 	GPIO_ClearValue(2, 1<<13); //LM4811-shutdn
 
-    if (SysTick_Config(SystemCoreClock / 1000)) {
-    	while (1);  // Capture error
-    }
+    serial_init();
+    histo_init(&h_sample, "sample_late", 2);
+    histo_init(&h_input, "input", 4);	// edge to redraw, the beep is not included
 
-    light_enable();
-    light_setRange(LIGHT_RANGE_4000);
+    input_init(&getTicks);
+    change7Seg(mode);
+    boot_mark(BOOT_DONE);
 
-	oled_clearScreen(OLED_COLOR_WHITE);
-	draw_graph_outline(3, OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+    sampleTime = getTicks();
+    // mode 0 keeps drawing into the boot frame, under the live title
+    show_reset(sensor);
 
     while(1) {
 
-    	joy = joystick_read();
+		loop_cyc = prof_begin();
+		cyc = prof_begin();
+		while (input_get(&ev)) {
+			trace_put(ev.tick, TRACE_INPUT, ev.src, ev.code, 0);
+			if (mode == MODE_SCOPE && ev.src != INPUT_SW3) {
+				scope_control(&ev);
+			}
+			else if (mode == MODE_SPECTRUM && ev.src != INPUT_SW3) {
+				spectrum_control(&ev);
+			}
+			else if (mode == MODE_DIAG && ev.src == INPUT_JOY && ev.code == JOYSTICK_CENTER) {
+				diag_export(&h_sample);
+				diag_export(&h_input);
+				diag_export_mem();
+				continue;
+			}
+			else if (mode == MODE_DIAG && ev.src == INPUT_JOY && ev.code == JOYSTICK_UP) {
+				trace_enable(!trace_enabled(), getTicks());
+				traced_mode = -1;	// a new trace starts with a mode record
+				draw_graph = 1;
+				continue;
+			}
+			else if (mode == MODE_DIAG && ev.src == INPUT_ROTARY) {
+				histo_init(&h_sample, h_sample.name, h_sample.width);
+				histo_init(&h_input, h_input.name, h_input.width);
+				fault_clear();
+				draw_graph = 1;
+				continue;
+			}
+			else if (mode == 2 && ev.src != INPUT_SW3) {
+				replay_control(&ev);
+			}
+			else if (ev.src == INPUT_JOY &&
+					(sel = sensor_find_joy(sensors, NUM_SENSORS, ev.code)) >= 0) {
+				data_type = sel;
+				sensor = &sensors[data_type];
+				note_pending = sensor->note;
+				replay_reset();
+				draw_graph = 1;
+				draw_recorded = 1;
+				draw_record = 1;
+			}
+			else if (ev.src == INPUT_SW3) {
+				if(mode == MODE_SCOPE || mode == MODE_SPECTRUM)
+					scope_leave();
+				mode++;
+				if(mode >= NUM_MODES)
+					mode = 0;
+				change7Seg(mode);
+				if(mode == 1){
+					playNote(getNote('F'), 400);
+					choose_interval();
+					playNote(getNote('D'), 400);
+					startTime = getTicks();
+					// time spent in the dialog is not input latency
+					ev.tick = startTime;
+				}
+				else{
+					note_pending = 'F';
+				}
+				if(mode == 2)
+					replay_reset();
+				draw_graph = 1;
+				draw_recorded = 1;
+				draw_record = 1;
+			}
+			else {
+				continue;
+			}
 
-		if ((joy & JOYSTICK_LEFT) != 0) {
-			// temperature
-			playNote(getNote('C'), 400);
-			data_type = 0;
-			oled_clearScreen(OLED_COLOR_WHITE);
-			draw_graph_outline(3, OLED_COLOR_BLACK, OLED_COLOR_WHITE);
-			draw_recorded = 1;
-			draw_record = 1;
+			// measured once this pass has redrawn, from the oldest edge
+			if (!input_pending) {
+				input_pending = 1;
+				input_tick = ev.tick;
+			}
 		}
+		prof_end(PROF_INPUT, cyc);
 
-		if ((joy & JOYSTICK_UP) != 0) {
-			// light
-			playNote(getNote('D'), 400);
-			data_type = 1;
-			oled_clearScreen(OLED_COLOR_WHITE);
-			draw_graph_outline(5, OLED_COLOR_BLACK, OLED_COLOR_WHITE);
-			draw_recorded = 1;
-			draw_record = 1;
+		if (trace_enabled() && (mode != traced_mode || data_type != traced_type)){
+			traced_mode = mode;
+			traced_type = data_type;
+			trace_put(getTicks(), TRACE_MODE, mode, data_type, 0);
 		}
 
-		if ((joy & JOYSTICK_RIGHT) != 0) {
-			// potenciometer
-			playNote(getNote('E'), 400);
-			data_type = 2;
-			oled_clearScreen(OLED_COLOR_WHITE);
-			draw_graph_outline(4, OLED_COLOR_BLACK, OLED_COLOR_WHITE);
-			draw_recorded = 1;
-			draw_record = 1;
-    	}
-
-		btn_1 = ((GPIO_ReadValue(0) >> 4) & 0x01);
-
-		if (btn_1 == 0){
-			mode++;
-//			clear_buffer(data_temp);
-//			clear_buffer(data_poten);
-//			clear_buffer(data_light);
-			playNote(getNote('F'), 400);
-			if(mode > 2)
-				mode = 0;
-			if(mode == 1){
-				time = 10;
-				oled_clearScreen(OLED_COLOR_WHITE);
-				oled_putString(1, 1, "Choose t (sec):", OLED_COLOR_BLACK, OLED_COLOR_WHITE);
-				intToString(time, buf, 10, 10);
-				oled_putString(35, 15, buf, OLED_COLOR_BLACK, OLED_COLOR_WHITE);
-				joy = joystick_read();
-				while(!(joy & JOYSTICK_CENTER)){
-					uint8_t rotaryDir = rotary_read();
-
-				    if (rotaryDir != ROTARY_WAIT) {
-
-				        if (rotaryDir == ROTARY_RIGHT) {
-				            time++;
-				            if (time > 60)
-				            	time = 60;
-				            intToString(time, buf, 10, 10);
-				            oled_putString(35, 15, buf, OLED_COLOR_BLACK, OLED_COLOR_WHITE);
-				        }
-				        else {
-				            time--;
-				            if (time < 10)
-				            	time = 10;
-				            intToString(time, buf, 10, 10);
-				            oled_putString(35, 15, buf, OLED_COLOR_BLACK, OLED_COLOR_WHITE);
-				        }
-
-				    }
-					joy = joystick_read();
-				}
-				playNote(getNote('D'), 400);
-				startTime = getTicks();
-			}
-			draw_graph = 1;
-			draw_recorded = 1;
-			draw_record = 1;
-		}
-
-		change7Seg(mode);
+		// reduce the vibration batches queued by the sampling interrupt
+		vib_get(&vib);
 
 		if(mode == 0){
+			if(draw_graph == 1 || getTicks() - sampleTime >= sensor->period_ms){
+				if (draw_graph == 0)
+					histo_add(&h_sample, getTicks() - sampleTime - sensor->period_ms);
+				sampleTime = getTicks();
 
-			// real - time buffer
-			if (data_type == 0){
-				if (draw_graph == 1){
-					draw_graph = 0;
-					oled_clearScreen(OLED_COLOR_WHITE);
-					draw_graph_outline(3, OLED_COLOR_BLACK, OLED_COLOR_WHITE);
-				}
-				/* Temperature */
-				oled_fillRect(75, 1, 90, 13, OLED_COLOR_WHITE);
-				oled_putString(1, 1, "Temperature:  ", OLED_COLOR_BLACK, OLED_COLOR_WHITE);
-				t = temp_read() / 10;
-				intToString(t, buf, 10, 10);
-				oled_fillRect(80, 0, 90, 8, OLED_COLOR_WHITE);
-				oled_putString(80, 1, buf, OLED_COLOR_BLACK, OLED_COLOR_WHITE);
-				fill_buffer(t, data_temp);
-				draw_data(25, 35, data_temp, BUFF_LEN);
-			}
-			else if (data_type == 1){
-				if (draw_graph == 1){
-					draw_graph = 0;
-					oled_clearScreen(OLED_COLOR_WHITE);
-					draw_graph_outline(5, OLED_COLOR_BLACK, OLED_COLOR_WHITE);
-				}
-				/* Light */
-				oled_fillRect(75, 1, 90, 13, OLED_COLOR_WHITE);
-				oled_putString(1, 1, "Light:  ", OLED_COLOR_BLACK, OLED_COLOR_WHITE);
-				light = light_read();
-				intToString(light, buf, 10, 10);
-				oled_fillRect(60, 0, 90, 8, OLED_COLOR_WHITE);
-				oled_putString(60, 1, buf, OLED_COLOR_BLACK, OLED_COLOR_WHITE);
-				fill_buffer(light, data_light);
-				draw_data(0, 500, data_light, BUFF_LEN);
-			}
-			else{
+				// real - time buffer
 				if (draw_graph == 1){
 					draw_graph = 0;
-					oled_clearScreen(OLED_COLOR_WHITE);
-					draw_graph_outline(4, OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+					draw_graph_outline(sensor->delimiter, OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+					show_reset(sensor);
 				}
-				/* Trimpot */
-				oled_fillRect(75, 1, 90, 13, OLED_COLOR_WHITE);
-				oled_putString(1, 1, "Poten:  ", OLED_COLOR_BLACK, OLED_COLOR_WHITE);
-				ADC_StartCmd(LPC_ADC,ADC_START_NOW);
-				//Wait conversion complete
-				while (!(ADC_ChannelGetStatus(LPC_ADC,ADC_CHANNEL_0,ADC_DATA_DONE)));
-				potenc = ADC_ChannelGetData(LPC_ADC,ADC_CHANNEL_0);
-				intToString(potenc, buf, 10, 10);
-				oled_fillRect(60, 0, 90, 8, OLED_COLOR_WHITE);
-				oled_putString(60, 1, buf, OLED_COLOR_BLACK, OLED_COLOR_WHITE);
-				fill_buffer(potenc, data_poten);
-				draw_data(99, 4100, data_poten, BUFF_LEN);
+				cyc = prof_begin();
+				raw = sensor_read(sensor);
+				value = sensor_scale(sensor, raw);
+				prof_end(PROF_SAMPLE, cyc);
+				trace_put(sampleTime, TRACE_SAMPLE, data_type, 0, value);
+				show_sample(sensor, raw);
+				fill_buffer(value, sensor->hist);
+				cyc = prof_begin();
+				draw_data(sensor->min, sensor->max, sensor->hist, BUFF_LEN);
+				prof_end(PROF_RENDER, cyc);
 			}
-
-	    	/* delay */
-	    	Timer0_Wait(1000);
 		}
 		else if(mode == 1){
 			if(draw_record == 1){
 				oled_clearScreen(OLED_COLOR_WHITE);
 				oled_putString(1, 1, "Write to EEPROM:  ", OLED_COLOR_BLACK, OLED_COLOR_WHITE);
 				draw_record = 0;
-				if(data_type == 0)
-					oled_putString(15, 30, "Temperature", OLED_COLOR_BLACK, OLED_COLOR_WHITE);
-				else if(data_type == 1)
-					oled_putString(33, 30, "Light", OLED_COLOR_BLACK, OLED_COLOR_WHITE);
-				else
-					oled_putString(10, 30, "Potentiometer", OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+				oled_putString(sensor->label_x, 30, (uint8_t*)sensor->label, OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+				oled_putString(1, 45, "Saved:", OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+				oled_putString(1, 54, "Skip:", OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+				numfield_init(&f_saved, 40, 45, 8, OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+				numfield_init(&f_skipped, 40, 54, 8, OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+				// the history holds live samples at another period or the
+				// boot frame; a record only takes samples from this session
+				clear_buffer(sensor->hist);
+				trig_init(&trig, &sensor->trig);
 			}
 			count = getTicks() - startTime;
 			if(count >= time*1000){
-				// zachuvaj vo memorija
-				if(data_type == 0){
-					t = temp_read() / 10;
-					fill_buffer(t, data_temp);
-					result = write_to_eeprom(data_temp, (uint16_t)TEMP_ADD);
-					if(result == 1)
-						return 1;
-				}
-				else if(data_type == 1){
-					light = light_read();
-					fill_buffer(light, data_light);
-					result = write_to_eeprom(data_light, (uint16_t)LIGHT_ADD);
-					if(result == 1)
-						return 1;
-				}
-				else{
-					ADC_StartCmd(LPC_ADC,ADC_START_NOW);
-					//Wait conversion complete
-					while (!(ADC_ChannelGetStatus(LPC_ADC,ADC_CHANNEL_0,ADC_DATA_DONE)));
-					potenc = ADC_ChannelGetData(LPC_ADC,ADC_CHANNEL_0);
-					fill_buffer(potenc, data_poten);
-					result = write_to_eeprom(data_poten, (uint16_t)POTEN_ADD);
-					if(draw_record)
-						oled_putString(10, 30, "Potentiometer", OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+				histo_add(&h_sample, count - time*1000);
+				// sample into RAM, write to EEPROM only when the trigger fires
+				cyc = prof_begin();
+				value = sensor_sample(sensor);
+				trace_put(getTicks(), TRACE_SAMPLE, data_type, 0, value);
+				fill_buffer(value, sensor->hist);
+				if(trig_sample(&trig, value)){
+					result = hist_append(&logs[data_type], sensor->hist,
+							(uint16_t)time, getTicks() / 1000);
 					if(result == 1)
 						return 1;
 				}
 
+				prof_end(PROF_RECORD, cyc);
+
+				numfield_show(&f_saved, buf, fmt_u32(trig.committed, buf));
+				numfield_show(&f_skipped, buf, fmt_u32(trig.skipped, buf));
+
 				count = 0;
 				startTime = getTicks();
 			}
 		}
-		else{
+		else if(mode == 2){
 			if (draw_recorded == 1){
+				cyc = prof_begin();
 				// prikazhi snimeno
-				if(data_type == 0){
-					oled_clearScreen(OLED_COLOR_WHITE);
-					draw_graph_outline(3, OLED_COLOR_BLACK, OLED_COLOR_WHITE);
-					oled_putString(1, 1, "Recorded temp:  ", OLED_COLOR_BLACK, OLED_COLOR_WHITE);
-					result = read_from_eeprom(data_temp, (uint16_t)TEMP_ADD);
-					if(result == 1)
-						return 1;
+				result = replay_draw();
+				if(result == 1)
+					return 1;
+				prof_end(PROF_REPLAY, cyc);
+			}
+			draw_recorded = 0;
 
-					draw_data(25, 35, data_temp, BUFF_LEN);
-				}
-				else if(data_type == 1){
-					oled_clearScreen(OLED_COLOR_WHITE);
-					draw_graph_outline(5, OLED_COLOR_BLACK, OLED_COLOR_WHITE);
-					oled_putString(1, 1, "Recorded light:  ", OLED_COLOR_BLACK, OLED_COLOR_WHITE);
-					result = read_from_eeprom(data_light, (uint16_t)LIGHT_ADD);
-					if(result == 1)
-						return 1;
+		}
+		else if(mode == MODE_SCOPE){
+			// oscilloscope on the BNC input
+			if (draw_graph == 1){
+				draw_graph = 0;
+				draw_graph_outline(4, OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+				scope_status();
+				scope_enter();
+			}
+			if (scope_poll(getTicks(), scope_pts)){
+				adc_peak = 0;
+				for (int i = 0; i < SCOPE_WIDTH; i++)
+					if (scope_pts[i] > adc_peak)
+						adc_peak = scope_pts[i];
+				cyc = prof_begin();
+				scope_draw(scope_pts, SCOPE_WIDTH);
+				prof_end(PROF_RENDER, cyc);
+			}
+		}
+		else if(mode == MODE_SPECTRUM){
+			// spectrum of AD0.0 blocks
+			const uint32_t* block;
+
+			if (draw_graph == 1){
+				draw_graph = 0;
+				draw_graph_outline(4, OLED_COLOR_BLACK, OLED_COLOR_WHITE);
+				spectrum_status();
+				scope_set_rate(spectrum_rates[spectrum_rate]);
+				scope_enter();
+			}
+			block = scope_block(1 << spectrum_log2n);
+			if (block != NULL)
+				spectrum_update(block);
+		}
+		else{
+			// timing histograms
+			if (draw_graph == 1 || getTicks() - diagTime >= DIAG_MS){
+				draw_graph = 0;
+				diagTime = getTicks();
+				diag_draw();
+			}
+		}
 
-					draw_data(0, 500, data_light, BUFF_LEN);
+		// LED bar level meter, written only when the level changes
+		if (getTicks() - ledTime >= LEDBAR_MS){
+			ledTime = getTicks();
+			if (mode == MODE_SCOPE || mode == MODE_SPECTRUM){
+				// full bar at the top code, blinking once the input clips
+				ledbar_show(ledbar_level(adc_peak, 0, 4095), adc_peak >= 4095);
+			}
+			else if (mode == MODE_DIAG){
+				ledbar_show(0, 0);
+			}
+			else if (mode == 2){
+				// newest point of the replayed view, dark without records
+				if (replay_n > 0){
+					value = replay_pts[replay_n - 1];
+					ledbar_show(ledbar_level(value, sensor->min, sensor->max),
+							value > sensor->max);
 				}
 				else{
-					oled_clearScreen(OLED_COLOR_WHITE);
-					draw_graph_outline(4, OLED_COLOR_BLACK, OLED_COLOR_WHITE);
-					oled_putString(1, 1, "Recorded poten:  ", OLED_COLOR_BLACK, OLED_COLOR_WHITE);
-					result = read_from_eeprom(data_poten, (uint16_t)POTEN_ADD);
-					if(result == 1)
-						return 1;
-					draw_data(99, 4100, data_poten, BUFF_LEN);
-
+					ledbar_show(0, 0);
 				}
 			}
-			draw_recorded = 0;
+			else{
+				// fast sensors are read now, slow ones show the newest sample
+				if (sensor->meter_live)
+					value = sensor_sample(sensor);
+				else
+					value = sensor->hist[BUFF_LEN - 1];
+				ledbar_show(ledbar_level(value, sensor->min, sensor->max),
+						value > sensor->max);
+			}
+		}
 
+		if (input_pending){
+			input_pending = 0;
+			histo_add(&h_input, getTicks() - input_tick);
 		}
+
+		// the beep blocks for 400 ms, so it waits until the redraw is out
+		if (note_pending){
+			playNote(getNote(note_pending), 400);
+			note_pending = 0;
+		}
+
+		// per period loop, EEPROM and display cost, then what the UART takes
+		prof_end(PROF_LOOP, loop_cyc);
+		trace_loop(getTicks(), prof[PROF_LOOP].last);
+		trace_flush();
+
+		// sleep until the next tick or input edge
+		__WFI();
     }
 
 }
@@ -0,0 +1,58 @@
+#include "memstat.h"
+
+/* from the managed linker script */
+extern unsigned int __base_RamLoc32;
+extern unsigned int __top_RamLoc32;
+extern unsigned int __base_RamAHB32;
+extern unsigned int __top_RamAHB32;
+extern unsigned int __end_bss_RAM2;
+extern unsigned int _pvHeapStart;	// end of .noinit, nothing uses a heap
+extern unsigned int _vStackTop;
+
+mem_region_t mem[MEM_NUM];
+
+/******************************************************************************
+ *
+ * Description:
+ *    Fill the stack below the caller with MEM_PAINT. Called by ResetISR()
+ *    once .bss is cleared, before anything else has used the stack.
+ *
+ *****************************************************************************/
+void mem_paint_stack(void)
+{
+	volatile unsigned int here;
+	unsigned int* p = &_pvHeapStart;
+	// stay clear of this frame
+	unsigned int* end = (unsigned int*)&here - 16;
+
+	while (p < end)
+		*p++ = MEM_PAINT;
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Refresh the region counters. The stack scan stops at the first
+ *    overwritten word, so it only walks the part that was never used.
+ *
+ *****************************************************************************/
+void mem_update(void)
+{
+	unsigned int* p = &_pvHeapStart;
+	unsigned int* top = &_vStackTop;
+
+	while (p < top && *p == MEM_PAINT)
+		p++;
+
+	mem[MEM_LOC].name = "RamLoc32";
+	mem[MEM_LOC].size = (uint32_t)&__top_RamLoc32 - (uint32_t)&__base_RamLoc32;
+	mem[MEM_LOC].statics = (uint32_t)&_pvHeapStart - (uint32_t)&__base_RamLoc32;
+	mem[MEM_LOC].stack = (uint32_t)top - (uint32_t)&_pvHeapStart;
+	mem[MEM_LOC].peak = (uint32_t)top - (uint32_t)p;
+
+	mem[MEM_AHB].name = "RamAHB32";
+	mem[MEM_AHB].size = (uint32_t)&__top_RamAHB32 - (uint32_t)&__base_RamAHB32;
+	mem[MEM_AHB].statics = (uint32_t)&__end_bss_RAM2 - (uint32_t)&__base_RamAHB32;
+	mem[MEM_AHB].stack = 0;
+	mem[MEM_AHB].peak = 0;
+}
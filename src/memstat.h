@@ -0,0 +1,33 @@
+/*****************************************************************************
+ *   RAM budget at run time. The free stack is painted at reset and the
+ *   deepest stack use is found by scanning for the first overwritten word;
+ *   static usage per region comes from the linker symbols.
+ *
+ ******************************************************************************/
+#ifndef MEMSTAT_H_
+#define MEMSTAT_H_
+
+#include "lpc_types.h"
+
+#define MEM_PAINT 0xC5C5C5C5
+
+typedef enum {
+	MEM_LOC = 0,		// RamLoc32: data, bss, noinit and the stack
+	MEM_AHB,			// RamAHB32: DMA buffers and histories
+	MEM_NUM
+} mem_region_id_t;
+
+typedef struct {
+	const char* name;
+	uint32_t size;		// region bytes
+	uint32_t statics;	// placed by the linker
+	uint32_t stack;		// bytes left to the stack
+	uint32_t peak;		// deepest stack use seen
+} mem_region_t;
+
+extern mem_region_t mem[MEM_NUM];
+
+void mem_paint_stack(void);
+void mem_update(void);
+
+#endif /* MEMSTAT_H_ */
@@ -0,0 +1,112 @@
+#include "numfmt.h"
+
+static const char pairs[201] =
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899";
+
+/******************************************************************************
+ *
+ * Description:
+ *    Write an unsigned value in decimal
+ *
+ * Params:
+ *   [in] value - value to write
+ *   [out] buf - at least FMT_BUF bytes, NUL terminated
+ *
+ * Returns:
+ *   Number of characters written, without the terminator
+ *
+ *****************************************************************************/
+uint8_t fmt_u32(uint32_t value, uint8_t* buf)
+{
+	uint8_t len = 1;
+	uint32_t t = value;
+	uint8_t* p;
+	uint32_t q, r;
+
+	while (t >= 10) {
+		t /= 10;
+		len++;
+	}
+
+	// fill from the last digit, two per step
+	p = buf + len;
+	*p = '\0';
+	while (value >= 100) {
+		q = value / 100;
+		r = (value - q * 100) * 2;
+		value = q;
+		*--p = pairs[r + 1];
+		*--p = pairs[r];
+	}
+	if (value >= 10) {
+		*--p = pairs[value * 2 + 1];
+		*--p = pairs[value * 2];
+	}
+	else {
+		*--p = (uint8_t)('0' + value);
+	}
+	return len;
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Write a signed value in decimal
+ *
+ * Params:
+ *   [in] value - value to write
+ *   [out] buf - at least FMT_BUF bytes, NUL terminated
+ *
+ * Returns:
+ *   Number of characters written, without the terminator
+ *
+ *****************************************************************************/
+uint8_t fmt_i32(int32_t value, uint8_t* buf)
+{
+	if (value < 0) {
+		buf[0] = '-';
+		// negate in unsigned so INT32_MIN does not overflow
+		return 1 + fmt_u32(0u - (uint32_t)value, buf + 1);
+	}
+	return fmt_u32((uint32_t)value, buf);
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Write a value kept in tenths with one decimal, e.g. 234 as "23.4"
+ *
+ * Params:
+ *   [in] value_x10 - value in tenths
+ *   [out] buf - at least FMT_BUF bytes, NUL terminated
+ *
+ * Returns:
+ *   Number of characters written, without the terminator
+ *
+ *****************************************************************************/
+uint8_t fmt_tenths(int32_t value_x10, uint8_t* buf)
+{
+	uint32_t u = (uint32_t)value_x10;
+	uint32_t whole;
+	uint8_t len = 0;
+
+	if (value_x10 < 0) {
+		buf[len++] = '-';
+		u = 0u - u;
+	}
+	whole = u / 10;
+	len += fmt_u32(whole, buf + len);
+	buf[len++] = '.';
+	buf[len++] = (uint8_t)('0' + (u - whole * 10));
+	buf[len] = '\0';
+	return len;
+}
@@ -0,0 +1,21 @@
+/*****************************************************************************
+ *   Decimal formatting for the display and the serial exports. Digits are
+ *   produced two at a time from a pair table with a constant divisor of
+ *   100, which the compiler turns into a multiply, instead of a runtime
+ *   base division per digit.
+ *
+ ******************************************************************************/
+#ifndef NUMFMT_H_
+#define NUMFMT_H_
+
+#include "lpc_types.h"
+
+/* enough for "-214748364.8", fmt_tenths() of INT32_MIN, and the
+ * terminator */
+#define FMT_BUF 13
+
+uint8_t fmt_u32(uint32_t value, uint8_t* buf);
+uint8_t fmt_i32(int32_t value, uint8_t* buf);
+uint8_t fmt_tenths(int32_t value_x10, uint8_t* buf);
+
+#endif /* NUMFMT_H_ */
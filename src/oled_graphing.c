@@ -4,10 +4,41 @@
 #include "lpc17xx_ssp.h"
 #include "oled.h"
 #include "font5x7.h"
+#include "oled_graphing.h"
 
 oled_color_t color_data;
 oled_color_t color_bg_data;
+uint32_t oled_bytes;
 
+/* bar heights on screen, so draw_bars() only touches what changed */
+static uint8_t bar_h[80];
+static uint8_t bar_n;
+
+/* font5x7 rows of the characters a numeric field can show, copied once so
+ * a cell is looked up by index; anything else is drawn as a space */
+static const uint8_t glyph_chars[] = " -.0123456789#";
+#define GLYPH_OVERFLOW 13		// '#', text too long for the field
+#define NUM_GLYPHS (sizeof(glyph_chars) - 1)
+static uint8_t glyphs[NUM_GLYPHS][8];
+static uint8_t glyphs_ready;
+
+
+int32_t __real_SSP_ReadWrite(LPC_SSP_TypeDef *SSPx, SSP_DATA_SETUP_Type *dataCfg,
+		SSP_TRANSFER_Type xfType);
+
+/* EA oled.c selects the display with P0.6 low; led7seg shares SSP1 */
+#define OLED_CS_PORT 0
+#define OLED_CS_PIN (1 << 6)
+
+/* every OLED command and data byte goes through here; only transfers made
+ * while the display is selected are counted, not the 7-segment ones */
+int32_t __wrap_SSP_ReadWrite(LPC_SSP_TypeDef *SSPx, SSP_DATA_SETUP_Type *dataCfg,
+		SSP_TRANSFER_Type xfType)
+{
+	if (SSPx == LPC_SSP1 && !(GPIO_ReadValue(OLED_CS_PORT) & OLED_CS_PIN))
+		oled_bytes += dataCfg->length;
+	return __real_SSP_ReadWrite(SSPx, dataCfg, xfType);
+}
 
 /******************************************************************************
  *
@@ -26,6 +57,7 @@ void draw_graph_outline(uint8_t delimiter, oled_color_t color, oled_color_t colo
 {
 	color_data = color;
 	color_bg_data = color_bg;
+	bar_n = 0;
 	oled_clearScreen(color_bg);
 	oled_line(10, 15, 10, 57, color);
 	oled_line(10, 57, 90, 57, color);
@@ -42,28 +74,153 @@ void draw_graph_outline(uint8_t delimiter, oled_color_t color, oled_color_t colo
 }
 
 
+/* data value as a pixel offset from the top of the graph, 0..40 */
+static int graph_y(uint16_t value, uint16_t min, uint16_t span)
+{
+	int32_t h;
+
+	if (value <= min)
+		return 40;
+	h = ((int32_t)(value - min) * 40) / span;
+	return h >= 40 ? 0 : 40 - h;
+}
+
 void draw_data(uint16_t min, uint16_t max, uint16_t* data, uint16_t data_size){
 	oled_fillRect(11, 15, 90, 56, color_bg_data);
 	int offset_x = 80 / data_size;
+	// integer scaling, the float version went through soft-float calls
+	uint16_t span = max > min ? max - min : 1;
+	int offset_y2 = 0;
 	for(int i=0; i< data_size; i++){
-		float temp = ((float)(data[i]-min))/(max-min) * 40;
-		if(temp < 0)
-			temp=0;
-		if(temp > 40)
-			temp = 40;
-		uint16_t norm_data = (uint16_t) temp;
-		int offset_y = 40 - norm_data;
-		if(i>0){
-			float temp2 = ((float)(data[i-1]-min))/(max-min) * 40;
-			if(temp2 < 0)
-				temp2=0;
-			if(temp2 > 40)
-				temp2 = 40;
-			uint16_t norm_data2 = (uint16_t) temp2;
-			int offset_y2 = 40 - norm_data2;
+		int offset_y = graph_y(data[i], min, span);
+		if(i>0)
 			oled_line(10 + offset_x*(i-1), 17 + offset_y2, 10 + offset_x*i, 17 + offset_y, color_data);
-		}
 		if(offset_y < 40)
 			oled_circle(10 + offset_x*i, 17 + offset_y, 1, color_data);
+		offset_y2 = offset_y;
+	}
+}
+
+
+/******************************************************************************
+ *
+ * Description:
+ *    Draw a bar chart in the graph area. Only the part of each bar that
+ *    differs from the previous call is drawn.
+ *
+ * Params:
+ *   [in] h - bar heights, 0..40
+ *   [in] n - number of bars
+ *   [in] width - width of a bar in pixels, n * width <= 80
+ *
+ *****************************************************************************/
+void draw_bars(const uint8_t* h, uint8_t n, uint8_t width)
+{
+	if (n != bar_n) {
+		oled_fillRect(11, 15, 90, 56, color_bg_data);
+		for (int i = 0; i < n; i++)
+			bar_h[i] = 0;
+		bar_n = n;
+	}
+	for (int i = 0; i < n; i++) {
+		uint8_t x0 = 11 + i * width;
+		uint8_t x1 = x0 + width - 1;
+		uint8_t hi = h[i] > 40 ? 40 : h[i];
+
+		if (hi > bar_h[i])
+			oled_fillRect(x0, 56 - hi + 1, x1, 56 - bar_h[i], color_data);
+		else if (hi < bar_h[i])
+			oled_fillRect(x0, 56 - bar_h[i] + 1, x1, 56 - hi, color_bg_data);
+		bar_h[i] = hi;
+	}
+}
+
+
+static uint8_t glyph_index(uint8_t ch)
+{
+	if (ch >= '0' && ch <= '9')
+		return 3 + (ch - '0');
+	if (ch == '-')
+		return 1;
+	if (ch == '.')
+		return 2;
+	return 0;
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Set up a numeric field. The area is taken to be cleared to the
+ *    background already, e.g. by draw_graph_outline(); call this again
+ *    whenever the screen is cleared.
+ *
+ * Params:
+ *   [in] f - field
+ *   [in] x, y - top left pixel
+ *   [in] cells - width in characters, at most NUMFIELD_CELLS
+ *   [in] fg, bg - text and background color
+ *
+ *****************************************************************************/
+void numfield_init(numfield_t* f, uint8_t x, uint8_t y, uint8_t cells,
+		oled_color_t fg, oled_color_t bg)
+{
+	int i, r;
+
+	if (!glyphs_ready) {
+		for (i = 0; i < (int)NUM_GLYPHS; i++)
+			for (r = 0; r < 8; r++)
+				glyphs[i][r] = font5x7[glyph_chars[i] - 0x20][r];
+		glyphs_ready = 1;
+	}
+	f->x = x;
+	f->y = y;
+	f->cells = cells > NUMFIELD_CELLS ? NUMFIELD_CELLS : cells;
+	f->fg = fg;
+	f->bg = bg;
+	for (i = 0; i < NUMFIELD_CELLS; i++)
+		f->shown[i] = 0;
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Show text right aligned in a field, padded with spaces. Only the
+ *    pixels of cells whose character changed are written, e.g. 23.4 to
+ *    23.5 costs the few pixels where '4' and '5' differ. Text that does
+ *    not fit fills the field with '#' rather than losing digits.
+ *
+ * Params:
+ *   [in] f - field
+ *   [in] text - digits, '-', '.' or ' ', as written by the fmt_*() functions
+ *   [in] len - characters in text
+ *
+ *****************************************************************************/
+void numfield_show(numfield_t* f, const uint8_t* text, uint8_t len)
+{
+	uint8_t pad = len < f->cells ? f->cells - len : 0;
+
+	for (int i = 0; i < f->cells; i++) {
+		uint8_t g;
+		uint8_t x = f->x + 6 * i;
+
+		if (len > f->cells)
+			g = GLYPH_OVERFLOW;
+		else
+			g = (i < pad) ? 0 : glyph_index(text[i - pad]);
+
+		if (g == f->shown[i])
+			continue;
+		for (int r = 0; r < 8; r++) {
+			uint8_t diff = glyphs[g][r] ^ glyphs[f->shown[i]][r];
+
+			for (int j = 0; diff != 0 && j < 6; j++) {
+				if (diff & (0x80 >> j)) {
+					oled_putPixel(x + j, f->y + r,
+							(glyphs[g][r] & (0x80 >> j)) ? f->fg : f->bg);
+					diff &= ~(0x80 >> j);
+				}
+			}
+		}
+		f->shown[i] = g;
 	}
 }
@@ -0,0 +1,30 @@
+#ifndef OLED_GRAPHING_H_
+#define OLED_GRAPHING_H_
+
+#include "oled.h"
+
+/* bytes sent to the display (OLED chip select active), counted by the
+ * SSP_ReadWrite() wrapper; the link wraps it with -Xlinker
+ * --wrap=SSP_ReadWrite */
+extern uint32_t oled_bytes;
+
+#define NUMFIELD_CELLS 8
+
+/* right aligned text field that remembers what it shows, so a new value
+ * only sends the pixels that differ */
+typedef struct {
+	uint8_t x, y;
+	uint8_t cells;				// width in 6 pixel characters
+	oled_color_t fg, bg;
+	uint8_t shown[NUMFIELD_CELLS];	// glyph index per cell
+} numfield_t;
+
+void numfield_init(numfield_t* f, uint8_t x, uint8_t y, uint8_t cells,
+		oled_color_t fg, oled_color_t bg);
+void numfield_show(numfield_t* f, const uint8_t* text, uint8_t len);
+
+void draw_graph_outline(uint8_t delimiter, oled_color_t color, oled_color_t color_bg);
+void draw_bars(const uint8_t* h, uint8_t n, uint8_t width);
+void draw_data(uint16_t min, uint16_t max, uint16_t* data, uint16_t data_size);
+
+#endif /* OLED_GRAPHING_H_ */
@@ -0,0 +1,73 @@
+#include "pool.h"
+
+/******************************************************************************
+ *
+ * Description:
+ *    Put every block on the free list. Must run before either side uses
+ *    the pool.
+ *
+ * Params:
+ *   [in] p - pool
+ *   [in] blocks - storage of count blocks
+ *   [in] block_size - bytes per block, keep it a multiple of 4
+ *   [in] count - number of blocks, at most the free list length
+ *
+ *****************************************************************************/
+void pool_init(pool_t* p, void* blocks, uint16_t block_size, uint16_t count)
+{
+	uint8_t* b = blocks;
+	uint16_t i;
+
+	spsc_reset(&p->free);
+	for (i = 0; i < count; i++) {
+		void* block = b + i * block_size;
+		spsc_put(&p->free, &block);
+	}
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Take a block off the free list. Only one context may allocate.
+ *
+ * Params:
+ *   [in] p - pool
+ *
+ * Returns:
+ *   The block, NULL if the pool is exhausted
+ *
+ *****************************************************************************/
+__RAMFUNC void* pool_alloc(pool_t* p)
+{
+	void* block;
+
+	if (!spsc_get(&p->free, &block))
+		return NULL;
+	return block;
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Return a block to the free list. Only one context may free.
+ *
+ * Params:
+ *   [in] p - pool
+ *   [in] block - block obtained from pool_alloc()
+ *
+ *****************************************************************************/
+void pool_free(pool_t* p, void* block)
+{
+	spsc_put(&p->free, &block);
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Number of blocks on the free list
+ *
+ *****************************************************************************/
+uint32_t pool_available(const pool_t* p)
+{
+	return spsc_count(&p->free);
+}
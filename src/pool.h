@@ -0,0 +1,27 @@
+/*****************************************************************************
+ *   Fixed block memory pool, sized at compile time. The free list is an
+ *   SPSC queue of block pointers, so one context may allocate (e.g. an
+ *   interrupt filling sample batches) while the other frees (the main loop
+ *   once it has consumed them) without disabling interrupts.
+ *
+ ******************************************************************************/
+#ifndef POOL_H_
+#define POOL_H_
+
+#include "lpc_types.h"
+#include "spsc.h"
+
+typedef struct {
+	spsc_t free;			// pointers to free blocks
+} pool_t;
+
+/* static initializer over the free list storage, an array of one void*
+ * per block whose length is a power of two; pool_init() fills it */
+#define POOL_INIT(slots) { SPSC_INIT(slots) }
+
+void pool_init(pool_t* p, void* blocks, uint16_t block_size, uint16_t count);
+__RAMFUNC void* pool_alloc(pool_t* p);
+void pool_free(pool_t* p, void* block);
+uint32_t pool_available(const pool_t* p);
+
+#endif /* POOL_H_ */
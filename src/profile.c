@@ -0,0 +1,78 @@
+#include "system_LPC17xx.h"
+#include "profile.h"
+
+prof_t prof[PROF_NUM];
+uint32_t boot_cycles[BOOT_NUM];
+
+/******************************************************************************
+ *
+ * Description:
+ *    Start the DWT cycle counter from zero. Called first thing in
+ *    ResetISR, before RAM is initialized, so it only touches registers.
+ *
+ *****************************************************************************/
+void prof_start(void)
+{
+	SCB_DEMCR |= (1 << 24);		// TRCENA
+	DWT_CYCCNT = 0;
+	DWT_CTRL |= 1;				// CYCCNTENA
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Clear all stage statistics. The cycle counter keeps running from
+ *    prof_start() so the boot steps stay measured from reset.
+ *
+ *****************************************************************************/
+void prof_init(void)
+{
+	int i;
+
+	for (i = 0; i < PROF_NUM; i++) {
+		prof[i].last = 0;
+		prof[i].max = 0;
+		prof[i].count = 0;
+	}
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Close a measurement started with prof_begin()
+ *
+ * Params:
+ *   [in] stage - stage the cycles are accounted to
+ *   [in] start - value returned by prof_begin()
+ *
+ *****************************************************************************/
+void prof_end(prof_stage_t stage, uint32_t start)
+{
+	uint32_t cycles = DWT_CYCCNT - start;
+
+	prof[stage].last = cycles;
+	if (cycles > prof[stage].max)
+		prof[stage].max = cycles;
+	prof[stage].count++;
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Time from reset to a boot step. Cycles up to BOOT_CLOCK are taken at
+ *    BOOT_EARLY_HZ, the rest at SystemCoreClock.
+ *
+ * Params:
+ *   [in] step - completed boot step
+ *
+ * Returns:
+ *   Milliseconds since reset
+ *
+ *****************************************************************************/
+uint32_t boot_ms(boot_step_t step)
+{
+	uint32_t early = boot_cycles[BOOT_CLOCK];
+
+	return early / (BOOT_EARLY_HZ / 1000) +
+			(boot_cycles[step] - early) / (SystemCoreClock / 1000);
+}
@@ -0,0 +1,71 @@
+/*****************************************************************************
+ *   Cycle counts of the main loop stages, taken from the Cortex-M3 DWT
+ *   cycle counter. Inspect prof[] with the debugger.
+ *
+ ******************************************************************************/
+#ifndef PROFILE_H_
+#define PROFILE_H_
+
+#include "lpc_types.h"
+
+/* a host build brings its own, see host/include/dwt.h */
+#ifndef DWT_CYCCNT
+#define DWT_CTRL   (*(volatile uint32_t*)0xE0001000)
+#define DWT_CYCCNT (*(volatile uint32_t*)0xE0001004)
+#define SCB_DEMCR  (*(volatile uint32_t*)0xE000EDFC)
+#endif
+
+typedef enum {
+	PROF_INPUT = 0,		// draining the input queue
+	PROF_SAMPLE,		// sensor reads
+	PROF_RENDER,		// OLED drawing
+	PROF_RECORD,		// trigger + EEPROM write
+	PROF_REPLAY,		// EEPROM read + drawing in mode 2
+	PROF_LOOP,			// whole main loop pass, without the sleep
+	PROF_NUM
+} prof_stage_t;
+
+typedef struct {
+	uint32_t last;
+	uint32_t max;
+	uint32_t count;
+} prof_t;
+
+extern prof_t prof[PROF_NUM];
+
+/* Boot steps, in the order they complete. Counting starts at the top of
+ * ResetISR, so the data copy, bss fill and SystemInit() are included. */
+typedef enum {
+	BOOT_CLOCK = 0,		// main() entered, PLL running
+	BOOT_BUS,			// I2C and SSP ready
+	BOOT_LIGHT,			// light sensor converting
+	BOOT_OLED,			// display initialized
+	BOOT_FIRST_FRAME,	// last recorded graph on screen
+	BOOT_DONE,			// remaining peripherals and input ready
+	BOOT_NUM
+} boot_step_t;
+
+/* DWT cycles since reset at which each boot step completed */
+extern uint32_t boot_cycles[BOOT_NUM];
+
+/* Before main() the core runs at about 4 MHz: the IRC, then the main
+ * oscillator divided by CCLKCFG while the PLL locks */
+#define BOOT_EARLY_HZ 4000000
+#define BOOT_TARGET_MS 100		// first frame on screen
+
+void prof_start(void);
+void prof_init(void);
+uint32_t boot_ms(boot_step_t step);
+void prof_end(prof_stage_t stage, uint32_t start);
+
+static inline uint32_t prof_begin(void)
+{
+	return DWT_CYCCNT;
+}
+
+static inline void boot_mark(boot_step_t step)
+{
+	boot_cycles[step] = DWT_CYCCNT;
+}
+
+#endif /* PROFILE_H_ */
@@ -0,0 +1,326 @@
+#include "lpc17xx_adc.h"
+#include "lpc17xx_gpdma.h"
+#include "oled.h"
+
+#include "scope.h"
+#include "sections.h"
+
+/* samples per displayed point; 1-2-5 steps from 5 us to 100 us per point */
+static const uint16_t decimation[] = { 1, 2, 5, 10, 20 };
+#define NUM_TIMEBASES (sizeof(decimation) / sizeof(decimation[0]))
+
+scope_cfg_t scope_cfg = { SCOPE_RISING, 2048, 64, 100, 0 };
+
+/* the GPDMA can only reach the AHB SRAM banks */
+static uint32_t capture[SCOPE_CAPTURE_LEN] __BSS_AHB;
+static uint16_t capture_len = SCOPE_CAPTURE_LEN;	// samples per capture
+
+static volatile uint8_t capture_done;
+static uint8_t capturing;
+static uint8_t triggered;
+static uint8_t dma_ready;
+static uint32_t rearm_tick;
+
+/* last trace drawn, erased point by point instead of clearing the area */
+static uint8_t last_y[SCOPE_WIDTH];
+static uint8_t last_n;
+
+__RAMFUNC void DMA_IRQHandler(void)
+{
+	if (GPDMA_IntGetStatus(GPDMA_STAT_INTTC, SCOPE_DMA_CH)) {
+		GPDMA_ClearIntPending(GPDMA_STATCLR_INTTC, SCOPE_DMA_CH);
+		LPC_ADC->ADCR &= ~(1 << 16);		// stop burst mode
+		capture_done = 1;
+	}
+	if (GPDMA_IntGetStatus(GPDMA_STAT_INTERR, SCOPE_DMA_CH)) {
+		GPDMA_ClearIntPending(GPDMA_STATCLR_INTERR, SCOPE_DMA_CH);
+		LPC_ADC->ADCR &= ~(1 << 16);
+		capture_done = 1;
+	}
+}
+
+static void start_capture(void)
+{
+	GPDMA_Channel_CFG_Type cfg;
+
+	// GPDMA_Setup() refuses a channel that is still enabled
+	GPDMA_ChannelCmd(SCOPE_DMA_CH, DISABLE);
+
+	cfg.ChannelNum = SCOPE_DMA_CH;
+	cfg.SrcMemAddr = 0;
+	cfg.DstMemAddr = (uint32_t)capture;
+	cfg.TransferSize = capture_len;
+	cfg.TransferWidth = 0;
+	cfg.TransferType = GPDMA_TRANSFERTYPE_P2M;
+	cfg.SrcConn = GPDMA_CONN_ADC;
+	cfg.DstConn = 0;
+	cfg.DMALLI = 0;
+	GPDMA_Setup(&cfg);
+
+	capture_done = 0;
+	capturing = 1;
+	GPDMA_ChannelCmd(SCOPE_DMA_CH, ENABLE);
+	ADC_BurstCmd(LPC_ADC, ENABLE);
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Switch AD0.0 to burst conversions with a DMA request per result and
+ *    arm the first capture. init_adc() must have been called.
+ *
+ *****************************************************************************/
+void scope_enter(void)
+{
+	if (!dma_ready) {
+		GPDMA_Init();
+		NVIC_EnableIRQ(DMA_IRQn);
+		dma_ready = 1;
+	}
+	// ADINTEN raises the DMA request; the ADC interrupt itself stays off
+	ADC_IntConfig(LPC_ADC, ADC_CHANNEL_0, ENABLE);
+	capture_len = SCOPE_CAPTURE_LEN;
+	triggered = 0;
+	last_n = 0;
+	start_capture();
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Stop capturing and give AD0.0 back to single software started
+ *    conversions.
+ *
+ *****************************************************************************/
+void scope_leave(void)
+{
+	ADC_BurstCmd(LPC_ADC, DISABLE);
+	GPDMA_ChannelCmd(SCOPE_DMA_CH, DISABLE);
+	ADC_IntConfig(LPC_ADC, ADC_CHANNEL_0, DISABLE);
+	capturing = 0;
+	scope_set_rate(SCOPE_RATE);
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Change the ADC conversion rate. Takes effect with the next capture.
+ *
+ * Params:
+ *   [in] rate - conversions per second, at most SCOPE_RATE
+ *
+ *****************************************************************************/
+void scope_set_rate(uint32_t rate)
+{
+	uint32_t inten = LPC_ADC->ADINTEN;
+
+	ADC_BurstCmd(LPC_ADC, DISABLE);
+	ADC_Init(LPC_ADC, rate);
+	ADC_ChannelCmd(LPC_ADC, ADC_CHANNEL_0, ENABLE);
+	LPC_ADC->ADINTEN = inten;
+	if (capturing)
+		start_capture();
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Untriggered block capture of only as many samples as asked for, so
+ *    a short FFT at a low rate does not wait for a full scope capture.
+ *    Returns the buffer once a capture has completed; it stays valid until
+ *    the next call, which starts the next capture.
+ *
+ * Params:
+ *   [in] len - samples needed, at most SCOPE_CAPTURE_LEN
+ *
+ * Returns:
+ *   At least len AD0GDR words or NULL while capturing
+ *
+ *****************************************************************************/
+const uint32_t* scope_block(uint16_t len)
+{
+	// a capture shorter than now needed is started over, and so is a
+	// longer one still running, e.g. the full scope capture armed by
+	// scope_enter(), so the first block only waits for len samples
+	if (!capturing || capture_len < len || (capture_len > len && !capture_done)) {
+		capture_len = len;
+		start_capture();
+		return NULL;
+	}
+	if (!capture_done)
+		return NULL;
+	capturing = 0;
+	return capture;
+}
+
+uint8_t scope_timebases(void)
+{
+	return NUM_TIMEBASES;
+}
+
+uint16_t scope_decimation(uint8_t timebase)
+{
+	return decimation[timebase];
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Find the first trigger edge in a capture. The signal has to be at
+ *    least hysteresis on the other side of level before the edge counts,
+ *    which keeps noise around the level from retriggering.
+ *
+ * Params:
+ *   [in] buf - AD0GDR words
+ *   [in] len - number of words in buf
+ *   [in] from - first index the trigger may be at (pre-trigger samples)
+ *   [in] to - index past the last allowed trigger position
+ *   [in] cfg - slope, level and hysteresis
+ *
+ * Returns:
+ *   Index of the trigger sample or -1 if there is none
+ *
+ *****************************************************************************/
+int scope_find_trigger(const uint32_t* buf, int len, int from, int to,
+		const scope_cfg_t* cfg)
+{
+	int armed = 0;
+	int lo = (int)cfg->level - cfg->hysteresis;
+	int hi = (int)cfg->level + cfg->hysteresis;
+	int i;
+
+	if (to > len)
+		to = len;
+
+	for (i = 0; i < to; i++) {
+		int v = SCOPE_SAMPLE(buf[i]);
+
+		// an edge before from is used up, it must not fire at from
+		if (cfg->slope == SCOPE_RISING) {
+			if (v < lo)
+				armed = 1;
+			else if (armed && v >= cfg->level) {
+				if (i >= from)
+					return i;
+				armed = 0;
+			}
+		}
+		else {
+			if (v > hi)
+				armed = 1;
+			else if (armed && v <= cfg->level) {
+				if (i >= from)
+					return i;
+				armed = 0;
+			}
+		}
+	}
+	return -1;
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Reduce a capture to n points by averaging factor samples per point
+ *
+ * Params:
+ *   [in] buf - AD0GDR words
+ *   [in] start - first sample to use
+ *   [in] factor - samples per point
+ *   [out] out - n 12 bit points
+ *   [in] n - number of points
+ *
+ *****************************************************************************/
+void scope_decimate(const uint32_t* buf, int start, int factor,
+		uint16_t* out, int n)
+{
+	int i, j;
+
+	for (i = 0; i < n; i++) {
+		uint32_t sum = 0;
+		const uint32_t* p = &buf[start + i * factor];
+
+		for (j = 0; j < factor; j++)
+			sum += SCOPE_SAMPLE(p[j]);
+		out[i] = (uint16_t)(sum / factor);
+	}
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Run the capture state machine: rearm after the holdoff and turn a
+ *    completed capture into a frame.
+ *
+ * Params:
+ *   [in] now - current ms tick
+ *   [out] pts - SCOPE_WIDTH points when a frame is returned
+ *
+ * Returns:
+ *   1 when pts holds a new frame, 0 otherwise
+ *
+ *****************************************************************************/
+int scope_poll(uint32_t now, uint16_t* pts)
+{
+	int factor, span, pre, trig;
+
+	if (!capturing) {
+		if ((int32_t)(now - rearm_tick) >= 0) {
+			capture_len = SCOPE_CAPTURE_LEN;
+			start_capture();
+		}
+		return 0;
+	}
+	if (!capture_done)
+		return 0;
+	capturing = 0;
+
+	factor = decimation[scope_cfg.timebase];
+	span = SCOPE_WIDTH * factor;
+	pre = span / 4;			// a quarter of the screen before the edge
+
+	trig = scope_find_trigger(capture, SCOPE_CAPTURE_LEN, pre,
+			SCOPE_CAPTURE_LEN - span + pre + 1, &scope_cfg);
+	if (trig >= 0) {
+		triggered = 1;
+		scope_decimate(capture, trig - pre, factor, pts, SCOPE_WIDTH);
+		rearm_tick = now + scope_cfg.holdoff_ms;
+	}
+	else {
+		// auto mode: show the free running capture
+		triggered = 0;
+		scope_decimate(capture, 0, factor, pts, SCOPE_WIDTH);
+		rearm_tick = now;
+	}
+	return 1;
+}
+
+int scope_triggered(void)
+{
+	return triggered;
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Draw a frame into the graph area of draw_graph_outline() (x = 11..90),
+ *    erasing the previous trace line by line rather than clearing the area
+ *
+ * Params:
+ *   [in] pts - 12 bit points
+ *   [in] n - number of points, at most SCOPE_WIDTH
+ *
+ *****************************************************************************/
+void scope_draw(const uint16_t* pts, int n)
+{
+	int i;
+
+	for (i = 1; i < last_n; i++)
+		oled_line(11 + i - 1, last_y[i - 1], 11 + i, last_y[i], OLED_COLOR_WHITE);
+
+	for (i = 0; i < n; i++)
+		last_y[i] = (uint8_t)(56 - ((uint32_t)pts[i] * 40) / 4095);
+	for (i = 1; i < n; i++)
+		oled_line(11 + i - 1, last_y[i - 1], 11 + i, last_y[i], OLED_COLOR_BLACK);
+	last_n = (uint8_t)n;
+}
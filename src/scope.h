@@ -0,0 +1,50 @@
+/*****************************************************************************
+ *   Triggered oscilloscope on the BNC/trimpot input (AD0.0). Bursts are
+ *   captured by DMA at the full ADC rate into AHB SRAM, searched for a
+ *   trigger edge and decimated down to the width of the graph area.
+ *
+ ******************************************************************************/
+#ifndef SCOPE_H_
+#define SCOPE_H_
+
+#include "lpc_types.h"
+
+#define SCOPE_CAPTURE_LEN 2048
+#define SCOPE_WIDTH 80			// points drawn, x = 11..90
+#define SCOPE_RATE 200000		// ADC samples per second
+#define SCOPE_DMA_CH 0
+
+/* 12 bit conversion result from an AD0GDR word written by the DMA */
+#define SCOPE_SAMPLE(w) ((uint16_t)(((w) >> 4) & 0xFFF))
+
+typedef enum {
+	SCOPE_RISING = 0,
+	SCOPE_FALLING
+} scope_slope_t;
+
+typedef struct {
+	scope_slope_t slope;
+	uint16_t level;			// ADC code, 0..4095
+	uint16_t hysteresis;	// how far past level the signal must be to arm
+	uint16_t holdoff_ms;	// minimum time between two triggered frames
+	uint8_t timebase;		// index into the decimation table
+} scope_cfg_t;
+
+extern scope_cfg_t scope_cfg;
+
+void scope_enter(void);
+void scope_leave(void);
+void scope_set_rate(uint32_t rate);
+const uint32_t* scope_block(uint16_t len);
+int scope_poll(uint32_t now, uint16_t* pts);
+int scope_triggered(void);
+uint8_t scope_timebases(void);
+uint16_t scope_decimation(uint8_t timebase);
+
+int scope_find_trigger(const uint32_t* buf, int len, int from, int to,
+		const scope_cfg_t* cfg);
+void scope_decimate(const uint32_t* buf, int start, int factor,
+		uint16_t* out, int n);
+void scope_draw(const uint16_t* pts, int n);
+
+#endif /* SCOPE_H_ */
@@ -0,0 +1,17 @@
+/*****************************************************************************
+ *   Placement of hot code and data. See the .ramfunc, .data_RAM2 and
+ *   .bss_RAM2 output sections in rdb1768cmsis_uart_Debug.ld.
+ *
+ ******************************************************************************/
+#ifndef SECTIONS_H_
+#define SECTIONS_H_
+
+/* Run from RamLoc32 (no flash wait states). RAM is out of BL range of
+ * flash, hence long_call; this must also be on the prototype callers see. */
+#define __RAMFUNC __attribute__ ((section(".ramfunc"), long_call, noinline))
+
+/* Zero initialised / initialised data in the 32 KB AHB SRAM bank */
+#define __BSS_AHB __attribute__ ((section(".bss.$RamAHB32")))
+#define __DATA_AHB __attribute__ ((section(".data.$RamAHB32")))
+
+#endif /* SECTIONS_H_ */
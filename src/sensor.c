@@ -0,0 +1,103 @@
+#include "sensor.h"
+
+/******************************************************************************
+ *
+ * Description:
+ *    Take one raw reading from a sensor: start the conversion if the
+ *    sensor needs it and complete it
+ *
+ * Params:
+ *   [in] s - sensor descriptor
+ *
+ * Returns:
+ *    Raw value, before scaling
+ *
+ *****************************************************************************/
+int32_t sensor_read(const sensor_t* s)
+{
+	if (s->start != NULL)
+		s->start();
+	return s->read();
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Scale a raw reading to the stored value
+ *
+ * Params:
+ *   [in] s - sensor descriptor
+ *   [in] raw - value from sensor_read()
+ *
+ * Returns:
+ *    raw / scale, truncated toward zero
+ *
+ *****************************************************************************/
+int32_t sensor_scale(const sensor_t* s, int32_t raw)
+{
+	if (s->scale > 1)
+		return raw / s->scale;
+	return raw;
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Scale a raw reading to the value shown on screen, with the sensor's
+ *    decimals kept as fixed point
+ *
+ * Params:
+ *   [in] s - sensor descriptor
+ *   [in] raw - value from sensor_read()
+ *
+ * Returns:
+ *    raw * 10^decimals / scale, truncated toward zero, e.g. 257 for
+ *    25.7 C when decimals is 1
+ *
+ *****************************************************************************/
+int32_t sensor_fixed(const sensor_t* s, int32_t raw)
+{
+	if (s->decimals > 0)
+		raw *= 10;
+	return sensor_scale(s, raw);
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Take one sample from a sensor and scale it
+ *
+ * Params:
+ *   [in] s - sensor descriptor
+ *
+ * Returns:
+ *    Scaled sample
+ *
+ *****************************************************************************/
+int32_t sensor_sample(const sensor_t* s)
+{
+	return sensor_scale(s, sensor_read(s));
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Find the sensor selected by a joystick direction
+ *
+ * Params:
+ *   [in] table - sensor descriptors
+ *   [in] n - number of descriptors
+ *   [in] joy - joystick code
+ *
+ * Returns:
+ *    Index into table, -1 if no sensor uses that direction
+ *
+ *****************************************************************************/
+int sensor_find_joy(const sensor_t* table, int n, uint8_t joy)
+{
+	for (int i = 0; i < n; i++) {
+		if (table[i].joy == joy)
+			return i;
+	}
+	return -1;
+}
@@ -0,0 +1,45 @@
+/*****************************************************************************
+ *   Sensor descriptors. Everything the graph, record and replay modes need
+ *   to know about a sensor lives in one table entry, so the main loop
+ *   dispatches through data_type instead of branching on it.
+ *
+ ******************************************************************************/
+#ifndef SENSOR_H_
+#define SENSOR_H_
+
+#include "lpc_types.h"
+#include "trigger.h"
+
+typedef struct sensor sensor_t;
+
+struct sensor {
+	const char* name;			// live graph title
+	const char* label;			// record screen label
+	const char* recorded;		// replay title
+	void (*start)(void);		// begin a conversion, may be NULL
+	int32_t (*read)(void);		// complete the conversion, raw value
+	void (*reset)(const sensor_t* s);	// own status line fields, NULL is one value field
+	void (*show)(int32_t value);	// own status line values, NULL shows the value
+	int16_t scale;				// raw / scale is the stored value
+	uint8_t decimals;			// digits after the point on screen, 0 or 1
+	uint16_t min;				// graph range
+	uint16_t max;
+	uint8_t delimiter;			// y axis ticks
+	uint8_t value_x;			// x of the live value
+	uint8_t label_x;			// x of the record screen label
+	uint8_t joy;				// joystick direction selecting the sensor
+	uint8_t note;				// note played when selected
+	uint16_t period_ms;			// live graph sample period
+	uint8_t meter_live;			// cheap enough to read at the LED bar rate
+	uint16_t eeprom_addr;		// recorded history
+	trig_cfg_t trig;			// recording trigger
+	uint16_t* hist;				// RAM history, BUFF_LEN samples
+};
+
+int32_t sensor_read(const sensor_t* s);
+int32_t sensor_scale(const sensor_t* s, int32_t raw);
+int32_t sensor_fixed(const sensor_t* s, int32_t raw);
+int32_t sensor_sample(const sensor_t* s);
+int sensor_find_joy(const sensor_t* table, int n, uint8_t joy);
+
+#endif /* SENSOR_H_ */
@@ -0,0 +1,78 @@
+#include "lpc17xx_pinsel.h"
+#include "lpc17xx_uart.h"
+
+#include "serial.h"
+
+/******************************************************************************
+ *
+ * Description:
+ *    Route P0.0/P0.1 to UART3 and enable the transmitter
+ *
+ *****************************************************************************/
+void serial_init(void)
+{
+	UART_CFG_Type uartCfg;
+	PINSEL_CFG_Type PinCfg;
+
+	PinCfg.Funcnum = 2;
+	PinCfg.OpenDrain = 0;
+	PinCfg.Pinmode = 0;
+	PinCfg.Portnum = 0;
+	PinCfg.Pinnum = 0;
+	PINSEL_ConfigPin(&PinCfg);
+	PinCfg.Pinnum = 1;
+	PINSEL_ConfigPin(&PinCfg);
+
+	UART_ConfigStructInit(&uartCfg);
+	uartCfg.Baud_rate = SERIAL_BAUD;
+	UART_Init(LPC_UART3, &uartCfg);
+	UART_TxCmd(LPC_UART3, ENABLE);
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Send bytes, blocking until they are all in the transmit FIFO
+ *
+ * Params:
+ *   [in] data - bytes to send
+ *   [in] len - number of bytes
+ *
+ *****************************************************************************/
+void serial_write(const uint8_t* data, uint32_t len)
+{
+	UART_Send(LPC_UART3, (uint8_t*)data, len, BLOCKING);
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Send a zero terminated string
+ *
+ *****************************************************************************/
+void serial_puts(const char* s)
+{
+	uint32_t len = 0;
+
+	while (s[len] != '\0')
+		len++;
+	serial_write((const uint8_t*)s, len);
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Send as many bytes as the transmit FIFO takes without waiting
+ *
+ * Params:
+ *   [in] data - bytes to send
+ *   [in] len - number of bytes
+ *
+ * Returns:
+ *   Number of bytes accepted
+ *
+ *****************************************************************************/
+uint32_t serial_write_nb(const uint8_t* data, uint32_t len)
+{
+	return UART_Send(LPC_UART3, (uint8_t*)data, len, NONE_BLOCKING);
+}
@@ -0,0 +1,18 @@
+/*****************************************************************************
+ *   Polled UART3 output (P0.0 TXD3, P0.1 RXD3), 115200 8N1. On the base
+ *   board UART3 reaches the USB serial bridge.
+ *
+ ******************************************************************************/
+#ifndef SERIAL_H_
+#define SERIAL_H_
+
+#include "lpc_types.h"
+
+#define SERIAL_BAUD 115200
+
+void serial_init(void);
+void serial_write(const uint8_t* data, uint32_t len);
+void serial_puts(const char* s);
+uint32_t serial_write_nb(const uint8_t* data, uint32_t len);
+
+#endif /* SERIAL_H_ */
@@ -0,0 +1,101 @@
+#include "spsc.h"
+
+/* keep the element copy on the right side of the index update; the
+ * "memory" clobber stops the compiler from moving it as well */
+#ifndef SPSC_BARRIER
+#define SPSC_BARRIER() __asm volatile ("dmb" ::: "memory")
+#endif
+
+/******************************************************************************
+ *
+ * Description:
+ *    Empty the queue and clear the drop counter. Neither side may be using
+ *    the queue while this runs.
+ *
+ * Params:
+ *   [in] q - queue
+ *
+ *****************************************************************************/
+void spsc_reset(spsc_t* q)
+{
+	q->head = 0;
+	q->tail = 0;
+	q->dropped = 0;
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Append a copy of an element. Producer side only.
+ *
+ * Params:
+ *   [in] q - queue
+ *   [in] item - element of q->size bytes
+ *
+ * Returns:
+ *   1 if queued, 0 if the queue was full (counted in q->dropped)
+ *
+ *****************************************************************************/
+__RAMFUNC int spsc_put(spsc_t* q, const void* item)
+{
+	uint32_t head = q->head;
+	const uint8_t* src = item;
+	uint8_t* dst;
+	int i;
+
+	if (head - q->tail >= q->len) {
+		q->dropped++;
+		return 0;
+	}
+	dst = q->buf + (head & (q->len - 1)) * q->size;
+	for (i = 0; i < q->size; i++)
+		dst[i] = src[i];
+	// publish the slot only after it has been filled in
+	SPSC_BARRIER();
+	q->head = head + 1;
+	return 1;
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Take a copy of the oldest element. Consumer side only.
+ *
+ * Params:
+ *   [in] q - queue
+ *   [out] item - element of q->size bytes
+ *
+ * Returns:
+ *   1 if an element was returned, 0 if the queue is empty
+ *
+ *****************************************************************************/
+__RAMFUNC int spsc_get(spsc_t* q, void* item)
+{
+	uint32_t tail = q->tail;
+	const uint8_t* src;
+	uint8_t* dst = item;
+	int i;
+
+	if (tail == q->head)
+		return 0;
+	SPSC_BARRIER();
+	src = q->buf + (tail & (q->len - 1)) * q->size;
+	for (i = 0; i < q->size; i++)
+		dst[i] = src[i];
+	// hand the slot back only after it has been copied out
+	SPSC_BARRIER();
+	q->tail = tail + 1;
+	return 1;
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Number of queued elements. Exact on the consumer side, a lower bound
+ *    anywhere else.
+ *
+ *****************************************************************************/
+uint32_t spsc_count(const spsc_t* q)
+{
+	return q->head - q->tail;
+}
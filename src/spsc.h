@@ -0,0 +1,40 @@
+/*****************************************************************************
+ *   Single producer / single consumer ring queue. One side (typically an
+ *   interrupt) only puts, the other (typically the main loop) only gets,
+ *   so neither has to disable interrupts. Elements are copied in and out.
+ *
+ ******************************************************************************/
+#ifndef SPSC_H_
+#define SPSC_H_
+
+#include "lpc_types.h"
+#include "sections.h"
+
+typedef struct {
+	uint8_t* buf;
+	uint16_t size;				// bytes per element
+	uint16_t len;				// elements, must be a power of two
+	volatile uint32_t head;		// written by the producer only
+	volatile uint32_t tail;		// written by the consumer only
+	volatile uint32_t dropped;	// puts refused because the queue was full
+} spsc_t;
+
+/* static initializer over an element array, e.g.
+ *   static input_event_t events[16];
+ *   static spsc_t queue = SPSC_INIT(events);
+ */
+#define SPSC_INIT(storage) \
+	{ (uint8_t*)(storage), sizeof((storage)[0]), \
+	  SPSC_LEN(storage) + SPSC_POW2_CHECK(SPSC_LEN(storage)), 0, 0, 0 }
+
+#define SPSC_LEN(storage) (sizeof(storage) / sizeof((storage)[0]))
+
+/* 0, or a compile error (negative array size) if n is not a power of two */
+#define SPSC_POW2_CHECK(n) (0 * sizeof(char[(n) != 0 && ((n) & ((n) - 1)) == 0 ? 1 : -1]))
+
+void spsc_reset(spsc_t* q);
+__RAMFUNC int spsc_put(spsc_t* q, const void* item);
+__RAMFUNC int spsc_get(spsc_t* q, void* item);
+uint32_t spsc_count(const spsc_t* q);
+
+#endif /* SPSC_H_ */
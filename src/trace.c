@@ -0,0 +1,167 @@
+#include "trace.h"
+#include "spsc.h"
+#include "sections.h"
+#include "serial.h"
+#include "history.h"
+#include "oled_graphing.h"
+
+typedef struct {
+	uint8_t b[TRACE_FRAME_BYTES];
+} trace_frame_t;
+
+/* about 0.8 s of output at 115200 baud */
+static trace_frame_t frames[64] __BSS_AHB;
+static spsc_t queue = SPSC_INIT(frames);
+
+/* frame being sent and how much of it the UART took */
+static trace_frame_t cur;
+static uint8_t cur_len;
+static uint8_t cur_off;
+
+static uint8_t enabled;
+
+/* counters of the running period */
+static uint32_t period_tick;
+static uint32_t passes;
+static uint32_t max_cycles;
+static uint32_t eeprom_mark;
+static uint32_t oled_mark;
+static uint32_t dropped_mark;
+
+static void put_le(uint8_t* p, uint32_t v, int n)
+{
+	int i;
+
+	for (i = 0; i < n; i++)
+		p[i] = (uint8_t)(v >> (8 * i));
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Start or stop tracing. Starting drops anything still queued and
+ *    begins a new counter period.
+ *
+ * Params:
+ *   [in] on - 1 to trace
+ *   [in] tick - current time in ms
+ *
+ *****************************************************************************/
+void trace_enable(int on, uint32_t tick)
+{
+	if (on && !enabled) {
+		spsc_reset(&queue);
+		cur_len = 0;
+		cur_off = 0;
+		period_tick = tick;
+		passes = 0;
+		max_cycles = 0;
+		eeprom_mark = hist_bytes_written;
+		oled_mark = oled_bytes;
+		dropped_mark = 0;
+	}
+	enabled = on ? 1 : 0;
+}
+
+int trace_enabled(void)
+{
+	return enabled;
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Queue one record. Nothing is queued while tracing is off; a record
+ *    that does not fit is counted as dropped.
+ *
+ * Params:
+ *   [in] tick - time in ms
+ *   [in] type - TRACE_*
+ *   [in] id, code, value - see trace.h
+ *
+ *****************************************************************************/
+void trace_put(uint32_t tick, uint8_t type, uint8_t id, uint16_t code, int32_t value)
+{
+	trace_frame_t f;
+	uint8_t sum = 0;
+	int i;
+
+	if (!enabled)
+		return;
+
+	f.b[0] = TRACE_SYNC;
+	put_le(&f.b[1], tick, 4);
+	f.b[5] = type;
+	f.b[6] = id;
+	put_le(&f.b[7], code, 2);
+	put_le(&f.b[9], (uint32_t)value, 4);
+	for (i = 1; i <= TRACE_REC_BYTES; i++)
+		sum += f.b[i];
+	f.b[TRACE_FRAME_BYTES - 1] = sum;
+
+	spsc_put(&queue, &f);
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Account one main loop pass. Once per TRACE_PERIOD_MS the passes,
+ *    the longest pass and the EEPROM and display bytes of the period are
+ *    queued.
+ *
+ * Params:
+ *   [in] tick - current time in ms
+ *   [in] cycles - DWT cycles the pass took
+ *
+ *****************************************************************************/
+void trace_loop(uint32_t tick, uint32_t cycles)
+{
+	uint32_t dropped;
+
+	if (!enabled)
+		return;
+
+	passes++;
+	if (cycles > max_cycles)
+		max_cycles = cycles;
+	if (tick - period_tick < TRACE_PERIOD_MS)
+		return;
+
+	dropped = queue.dropped - dropped_mark;
+	dropped_mark = queue.dropped;
+	trace_put(tick, TRACE_LOOP, (uint8_t)(dropped > 255 ? 255 : dropped),
+			(uint16_t)(passes > 0xFFFF ? 0xFFFF : passes), (int32_t)max_cycles);
+	trace_put(tick, TRACE_EEPROM, 0, 0, (int32_t)(hist_bytes_written - eeprom_mark));
+	trace_put(tick, TRACE_DISPLAY, 0, 0, (int32_t)(oled_bytes - oled_mark));
+
+	period_tick = tick;
+	passes = 0;
+	max_cycles = 0;
+	eeprom_mark = hist_bytes_written;
+	oled_mark = oled_bytes;
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Hand queued frames to the UART transmit FIFO without waiting for it
+ *    to drain. Called once per main loop pass.
+ *
+ *****************************************************************************/
+void trace_flush(void)
+{
+	uint32_t n;
+
+	while (1) {
+		if (cur_off == cur_len) {
+			if (!spsc_get(&queue, &cur))
+				return;
+			cur_len = TRACE_FRAME_BYTES;
+			cur_off = 0;
+		}
+		n = serial_write_nb(&cur.b[cur_off], cur_len - cur_off);
+		cur_off += n;
+		if (cur_off < cur_len)
+			return;		// FIFO full
+	}
+}
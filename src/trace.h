@@ -0,0 +1,45 @@
+/*****************************************************************************
+ *   Trace of sensor readings, input events and per-period cost counters,
+ *   streamed over UART3 while enabled. tools/trace_record.py stores the
+ *   records in a .lpct file and tools/trace_check.py compares the counters
+ *   against a baseline; host/replay.c replays the inputs and samples
+ *   through a host build of the main loop. The layout below is mirrored
+ *   in tools/trace_format.py.
+ *
+ *   Record, 12 bytes little endian:
+ *     uint32 tick    ms since boot
+ *     uint8  type    TRACE_*
+ *     uint8  id      sensor, input source or mode
+ *     uint16 code    joystick code, passes, ...
+ *     int32  value   reading or counter
+ *
+ *   On the wire each record is framed as TRACE_SYNC, the 12 record bytes
+ *   and the low byte of their sum.
+ *
+ ******************************************************************************/
+#ifndef TRACE_H_
+#define TRACE_H_
+
+#include "lpc_types.h"
+
+#define TRACE_SYNC 0xA5
+#define TRACE_REC_BYTES 12
+#define TRACE_FRAME_BYTES (TRACE_REC_BYTES + 2)
+
+/* counters are reported once per period */
+#define TRACE_PERIOD_MS 100
+
+#define TRACE_SAMPLE 1		// id sensor, value scaled reading
+#define TRACE_INPUT 2		// id input source, code event code
+#define TRACE_LOOP 3		// id frames dropped (255 max), code passes, value max cycles
+#define TRACE_EEPROM 4		// value bytes written in the period
+#define TRACE_DISPLAY 5		// value bytes sent to the OLED in the period
+#define TRACE_MODE 6		// id mode, code sensor
+
+void trace_enable(int on, uint32_t tick);
+int trace_enabled(void);
+void trace_put(uint32_t tick, uint8_t type, uint8_t id, uint16_t code, int32_t value);
+void trace_loop(uint32_t tick, uint32_t cycles);
+void trace_flush(void);
+
+#endif /* TRACE_H_ */
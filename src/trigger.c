@@ -0,0 +1,111 @@
+#include "trigger.h"
+
+static int32_t delta_abs(int32_t a, int32_t b)
+{
+	return (a > b) ? (a - b) : (b - a);
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Reset trigger state and statistics and arm it with a configuration
+ *
+ * Params:
+ *   [in] s - trigger state
+ *   [in] cfg - trigger configuration
+ *
+ *****************************************************************************/
+void trig_init(trig_state_t* s, const trig_cfg_t* cfg)
+{
+	s->cfg = cfg;
+	s->last = 0;
+	s->have_last = 0;
+	s->armed = 1;
+	s->capturing = 0;
+	s->post_left = 0;
+	s->filled = 0;
+	s->pending = 0;
+	s->committed = 0;
+	s->skipped = 0;
+}
+
+static int fires(const trig_state_t* s, int32_t value)
+{
+	const trig_cfg_t* cfg = s->cfg;
+
+	if (cfg->kind == TRIG_LEVEL_ABOVE)
+		return value >= cfg->level;
+	if (cfg->kind == TRIG_LEVEL_BELOW)
+		return value <= cfg->level;
+	return s->have_last && delta_abs(value, s->last) >= cfg->level;
+}
+
+static int rearms(const trig_state_t* s, int32_t value)
+{
+	const trig_cfg_t* cfg = s->cfg;
+
+	if (cfg->kind == TRIG_LEVEL_ABOVE)
+		return value < cfg->level - cfg->deadband;
+	if (cfg->kind == TRIG_LEVEL_BELOW)
+		return value > cfg->level + cfg->deadband;
+	return delta_abs(value, s->last) < cfg->level - cfg->deadband;
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Feed one sample through the trigger. The caller keeps the sample
+ *    history; a return value of 1 means the last cfg->pre + 1 + cfg->post
+ *    samples of that history should now be written out. The trigger does
+ *    not fire before cfg->pre samples have been fed since trig_init(), so
+ *    a window never reaches back past the start of the recording.
+ *
+ * Params:
+ *   [in] s - trigger state
+ *   [in] value - new sample
+ *
+ * Returns:
+ *   1 when an event window is complete, 0 otherwise
+ *
+ *****************************************************************************/
+__RAMFUNC int trig_sample(trig_state_t* s, int32_t value)
+{
+	int ready = 0;
+
+	s->pending++;
+
+	if (s->capturing) {
+		if (--s->post_left == 0)
+			ready = 1;
+	}
+	else if (s->armed) {
+		if (s->filled >= s->cfg->pre && fires(s, value)) {
+			s->armed = 0;
+			s->capturing = 1;
+			s->post_left = s->cfg->post;
+			if (s->post_left == 0)
+				ready = 1;
+		}
+	}
+	else if (rearms(s, value)) {
+		s->armed = 1;
+	}
+
+	if (ready) {
+		s->capturing = 0;
+		s->committed += s->pending;
+		s->pending = 0;
+	}
+	else if (!s->capturing && s->pending > s->cfg->pre) {
+		// too old to end up in front of the next event
+		s->skipped += s->pending - s->cfg->pre;
+		s->pending = s->cfg->pre;
+	}
+
+	if (s->filled < s->cfg->pre)
+		s->filled++;
+	s->last = value;
+	s->have_last = 1;
+
+	return ready;
+}
@@ -0,0 +1,43 @@
+/*****************************************************************************
+ *   Event trigger for recording mode. Samples are collected continuously
+ *   into the RAM history buffer and the trigger decides when that history
+ *   is worth committing to EEPROM.
+ *
+ ******************************************************************************/
+#ifndef TRIGGER_H_
+#define TRIGGER_H_
+
+#include "lpc_types.h"
+#include "sections.h"
+
+typedef enum {
+	TRIG_LEVEL_ABOVE = 0,	// value rises to or above level
+	TRIG_LEVEL_BELOW,		// value falls to or below level
+	TRIG_RATE				// |value - previous| reaches level
+} trig_kind_t;
+
+typedef struct {
+	trig_kind_t kind;
+	int32_t level;
+	int32_t deadband;		// hysteresis the value must clear before re-arming
+	uint8_t pre;			// samples kept from before the event
+	uint8_t post;			// samples captured after the event
+} trig_cfg_t;
+
+typedef struct {
+	const trig_cfg_t* cfg;
+	int32_t last;
+	uint8_t have_last;
+	uint8_t armed;
+	uint8_t capturing;
+	uint8_t post_left;
+	uint8_t filled;			// samples taken since trig_init(), up to cfg->pre
+	uint32_t pending;		// samples that may still be part of a window
+	uint32_t committed;
+	uint32_t skipped;
+} trig_state_t;
+
+void trig_init(trig_state_t* s, const trig_cfg_t* cfg);
+__RAMFUNC int trig_sample(trig_state_t* s, int32_t value);
+
+#endif /* TRIGGER_H_ */
@@ -0,0 +1,259 @@
+#include "lpc17xx_i2c.h"
+#include "lpc17xx_timer.h"
+
+#include "acc.h"
+
+#include "vibration.h"
+#include "i2c_bus.h"
+#include "sections.h"
+#include "intmath.h"
+#include "spsc.h"
+#include "pool.h"
+
+#define ACC_I2C_ADDR 0x1D
+#define ACC_CTL1 0x18
+#define ACC_CTL1_DFBW 0x80		// 125 Hz bandwidth, 250 Hz output rate
+#define ACC_XOUT8 0x06			// X, Y, Z 8 bit outputs follow
+
+#define ACC_TIMEOUT 3			// sample periods a read may take before it is aborted
+
+#define VIB_BATCH 32			// samples handed over at a time
+#define VIB_BLOCKS 8			// ~1 s of batches, a power of two
+
+volatile uint8_t i2c_bus_busy;
+volatile uint8_t i2c_bus_acc;
+
+typedef struct {
+	int8_t xyz[VIB_BATCH][3];
+} vib_batch_t;
+
+/* batches are filled by the interrupt and reduced by the main loop */
+static vib_batch_t blocks[VIB_BLOCKS] __BSS_AHB;
+static void* free_slots[VIB_BLOCKS];
+static pool_t pool = POOL_INIT(free_slots);
+static vib_batch_t* full_slots[VIB_BLOCKS];
+static spsc_t full = SPSC_INIT(full_slots);
+
+/* interrupt side */
+static vib_batch_t* filling;
+static uint16_t fill_n;
+static volatile uint16_t missed;
+static uint8_t acc_reg = ACC_XOUT8;
+static I2C_M_SETUP_Type acc_xfer;	// read in flight, owned by the interrupts
+static uint8_t acc_age;
+
+/* window accumulators, main loop side */
+static int32_t sum[3];
+static uint32_t sumsq[3];
+static int8_t dc[3];		// mean of the previous window
+static uint8_t dc_seeded;
+static uint32_t peak_sq;
+static uint16_t n;
+
+static vib_metrics_t result;
+static uint8_t ready;
+
+static void close_window(void)
+{
+	uint32_t var = 0;
+	uint32_t rms, peak;
+	int i;
+
+	for (i = 0; i < 3; i++) {
+		int32_t mean = sum[i] / VIB_WINDOW;
+		// N * var = sum(x^2) - sum(x)^2 / N
+		var += (sumsq[i] - (uint32_t)((sum[i] * sum[i]) / VIB_WINDOW)) / VIB_WINDOW;
+		dc[i] = (int8_t)mean;
+		sum[i] = 0;
+		sumsq[i] = 0;
+	}
+
+	// raw LSB scaled by 8 so the root keeps three extra bits
+	rms = isqrt32(var * 64);
+	peak = isqrt32(peak_sq * 64);
+	result.rms_mg = (uint16_t)((rms * VIB_MG_PER_LSB_X8) / 64);
+	result.peak_mg = (uint16_t)((peak * VIB_MG_PER_LSB_X8) / 64);
+	result.crest_x10 = rms ? (uint16_t)((peak * 10) / rms) : 0;
+	result.missed = missed;
+	ready = 1;
+
+	peak_sq = 0;
+	n = 0;
+}
+
+static void reduce(const vib_batch_t* b)
+{
+	uint32_t d2;
+	int i, k;
+
+	// the first batch gives the DC level (gravity) for the first window
+	if (!dc_seeded) {
+		for (i = 0; i < 3; i++) {
+			int32_t s = 0;
+			for (k = 0; k < VIB_BATCH; k++)
+				s += b->xyz[k][i];
+			dc[i] = (int8_t)(s / VIB_BATCH);
+		}
+		dc_seeded = 1;
+	}
+
+	for (k = 0; k < VIB_BATCH; k++) {
+		d2 = 0;
+		for (i = 0; i < 3; i++) {
+			int32_t v = b->xyz[k][i];
+			int32_t d = v - dc[i];
+			sum[i] += v;
+			sumsq[i] += (uint32_t)(v * v);
+			d2 += (uint32_t)(d * d);
+		}
+		if (d2 > peak_sq)
+			peak_sq = d2;
+		if (++n == VIB_WINDOW)
+			close_window();
+	}
+}
+
+/* give up on a read the bus never finished, e.g. the MMA7455 holds SDA */
+static void acc_abort(void)
+{
+	I2C_IntCmd(LPC_I2C2, FALSE);
+	LPC_I2C2->I2CONSET = I2C_I2CONSET_STO;
+	LPC_I2C2->I2CONCLR = I2C_I2CONCLR_SIC | I2C_I2CONCLR_STAC;
+	i2c_bus_acc = 0;
+	missed++;
+}
+
+/* Starts the read of one sample; I2C2_IRQHandler() completes it, so the
+ * timer interrupt never waits on the bus. */
+__RAMFUNC void TIMER1_IRQHandler(void)
+{
+	TIM_ClearIntPending(LPC_TIM1, TIM_MR0_INT);
+
+	if (i2c_bus_acc) {
+		if (++acc_age >= ACC_TIMEOUT)
+			acc_abort();
+		else
+			missed++;
+		return;
+	}
+	if (filling == NULL) {
+		filling = pool_alloc(&pool);
+		fill_n = 0;
+	}
+	// no block (main loop behind) or bus in use: the sample is lost
+	if (filling == NULL || i2c_bus_busy) {
+		missed++;
+		return;
+	}
+
+	acc_xfer.sl_addr7bit = ACC_I2C_ADDR;
+	acc_xfer.tx_data = &acc_reg;
+	acc_xfer.tx_length = 1;
+	acc_xfer.rx_data = (uint8_t*)filling->xyz[fill_n];
+	acc_xfer.rx_length = 3;
+	acc_xfer.retransmissions_max = 1;
+	acc_xfer.callback = NULL;
+	acc_age = 0;
+	i2c_bus_acc = 1;
+	I2C_MasterTransferData(LPC_I2C2, &acc_xfer, I2C_TRANSFER_INTERRUPT);
+}
+
+__RAMFUNC void I2C2_IRQHandler(void)
+{
+	I2C_MasterHandler(LPC_I2C2);
+	if (!I2C_MasterTransferComplete(LPC_I2C2))
+		return;
+
+	// polled transfers of the main loop must not land here
+	I2C_IntCmd(LPC_I2C2, FALSE);
+	i2c_bus_acc = 0;
+	if (acc_xfer.rx_count != acc_xfer.rx_length) {
+		missed++;
+		return;
+	}
+	if (++fill_n == VIB_BATCH) {
+		spsc_put(&full, &filling);
+		filling = NULL;
+	}
+}
+
+static void set_output_rate(void)
+{
+	I2C_M_SETUP_Type setup;
+	uint8_t buf[2] = { ACC_CTL1, ACC_CTL1_DFBW };
+
+	setup.sl_addr7bit = ACC_I2C_ADDR;
+	setup.tx_data = buf;
+	setup.tx_length = 2;
+	setup.rx_data = NULL;
+	setup.rx_length = 0;
+	setup.retransmissions_max = 3;
+	I2C_MasterTransferData(LPC_I2C2, &setup, I2C_TRANSFER_POLLING);
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Put the accelerometer in 2g measurement mode at 250 Hz and start the
+ *    TIMER1 sampling interrupt. init_i2c() must have been called.
+ *
+ *****************************************************************************/
+void vib_init(void)
+{
+	TIM_TIMERCFG_Type timerCfg;
+	TIM_MATCHCFG_Type matchCfg;
+
+	pool_init(&pool, blocks, sizeof(blocks[0]), VIB_BLOCKS);
+	spsc_reset(&full);
+
+	acc_init();
+	acc_setRange(ACC_RANGE_2G);
+	acc_setMode(ACC_MODE_MEASURE);
+	set_output_rate();
+
+	timerCfg.PrescaleOption = TIM_PRESCALE_USVAL;
+	timerCfg.PrescaleValue = 1;
+	matchCfg.MatchChannel = 0;
+	matchCfg.IntOnMatch = TRUE;
+	matchCfg.ResetOnMatch = TRUE;
+	matchCfg.StopOnMatch = FALSE;
+	matchCfg.ExtMatchOutputType = TIM_EXTMATCH_NOTHING;
+	matchCfg.MatchValue = 1000000 / VIB_RATE;
+
+	TIM_Init(LPC_TIM1, TIM_TIMER_MODE, &timerCfg);
+	TIM_ConfigMatch(LPC_TIM1, &matchCfg);
+
+	// same priority as SysTick: neither preempts the other
+	NVIC_SetPriority(TIMER1_IRQn, 31);
+	NVIC_SetPriority(I2C2_IRQn, 31);
+	NVIC_EnableIRQ(TIMER1_IRQn);
+	TIM_Cmd(LPC_TIM1, ENABLE);
+}
+
+/******************************************************************************
+ *
+ * Description:
+ *    Reduce the sample batches queued by the interrupt and fetch the
+ *    metrics of the last completed window. Main loop only.
+ *
+ * Params:
+ *   [out] m - metrics
+ *
+ * Returns:
+ *   1 if a new window completed since the last call, 0 otherwise
+ *
+ *****************************************************************************/
+int vib_get(vib_metrics_t* m)
+{
+	vib_batch_t* b;
+	int fresh;
+
+	while (spsc_get(&full, &b)) {
+		reduce(b);
+		pool_free(&pool, b);
+	}
+	fresh = ready;
+	ready = 0;
+	*m = result;
+	return fresh;
+}
@@ -0,0 +1,27 @@
+/*****************************************************************************
+ *   Vibration monitoring with the MMA7455 accelerometer. All three axes are
+ *   read at the 250 Hz output rate by interrupt driven I2C transfers that a
+ *   timer starts, and handed to the main loop in batches; every window
+ *   yields RMS, peak and crest factor of the AC part of the signal.
+ *
+ ******************************************************************************/
+#ifndef VIBRATION_H_
+#define VIBRATION_H_
+
+#include "lpc_types.h"
+
+#define VIB_RATE 250			// samples per second
+#define VIB_WINDOW 256			// samples per metrics window, ~1 s
+#define VIB_MG_PER_LSB_X8 125	// 2g range, 64 LSB/g: 15.625 mg * 8
+
+typedef struct {
+	uint16_t rms_mg;		// RMS of the vector magnitude, DC removed
+	uint16_t peak_mg;		// largest deviation from the DC level
+	uint16_t crest_x10;		// peak / rms in tenths
+	uint16_t missed;		// samples skipped: I2C busy or failed, no free batch
+} vib_metrics_t;
+
+void vib_init(void);
+int vib_get(vib_metrics_t* m);
+
+#endif /* VIBRATION_H_ */
@@ -0,0 +1,170 @@
+#!/usr/bin/env python
+"""Size report from a GNU ld map file (e.g. Debug/bnc_oled.map).
+
+Prints the usage of each memory region, the flash/RAM footprint of every
+module split by region, the functions that execute from RAM and the RAM
+budget: static RAM per module and what RamLoc32 leaves for the stack.
+
+    python tools/map_report.py Debug/bnc_oled.map
+    python tools/map_report.py --ram Debug/bnc_oled.map   (sort by RAM)
+"""
+import re
+import sys
+
+SECTION_RE = re.compile(r'^ (\S+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(.+)$')
+CONT_RE = re.compile(r'^\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(.+)$')
+NAME_RE = re.compile(r'^ (\S+)$')
+REGION_RE = re.compile(r'^(\w+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)')
+OUTPUT_RE = re.compile(r'^(\.\S+)')
+
+# output sections that occupy target memory (debug info is also at 0x0)
+LOADED = ('.text', '.ARM.extab', '.ARM.exidx', '.data', '.data_RAM2',
+          '.bss', '.bss_RAM2', '.noinit', '.noinit_RAM2', '.uninit_RESERVED')
+
+
+def module_name(path):
+    path = path.replace('\\', '/')
+    m = re.search(r'([^/]+\.a)\(([^)]+)\)$', path)
+    if m:
+        return '%s(%s)' % (m.group(1), m.group(2))
+    return path.rsplit('/', 1)[-1]
+
+
+def parse(lines):
+    regions = []
+    sections = []	# (input section, address, size, module)
+    in_map = False
+    pending = None
+    output = None
+
+    for line in lines:
+        line = line.rstrip('\n')
+        if not in_map:
+            m = REGION_RE.match(line)
+            if m and m.group(1) not in ('Name',):
+                regions.append((m.group(1), int(m.group(2), 16),
+                                int(m.group(3), 16)))
+            if line.startswith('Linker script and memory map'):
+                in_map = True
+            continue
+
+        m = OUTPUT_RE.match(line)
+        if m:
+            output = m.group(1)
+            pending = None
+            continue
+        if output not in LOADED:
+            continue
+
+        m = SECTION_RE.match(line)
+        if m:
+            pending = None
+            sections.append((m.group(1), int(m.group(2), 16),
+                             int(m.group(3), 16), module_name(m.group(4))))
+            continue
+        m = NAME_RE.match(line)
+        if m and m.group(1).startswith('.'):
+            pending = m.group(1)
+            continue
+        m = CONT_RE.match(line)
+        if m and pending:
+            sections.append((pending, int(m.group(1), 16),
+                             int(m.group(2), 16), module_name(m.group(3))))
+        pending = None
+
+    return regions, sections
+
+
+def region_of(regions, addr):
+    for name, origin, length in regions:
+        if name != '*default*' and origin <= addr < origin + length:
+            return name
+    return None
+
+
+def kind_of(name):
+    if name.startswith('.ramfunc'):
+        return 'ramfunc'
+    if name.startswith('.bss') or name == 'COMMON':
+        return 'bss'
+    if name.startswith('.data'):
+        return 'data'
+    if name.startswith('.noinit'):
+        return 'noinit'
+    return 'text'
+
+
+def ram_of(sizes):
+    return sum(v for (region, kind), v in sizes.items()
+               if region.startswith('Ram'))
+
+
+def main(argv):
+    by_ram = '--ram' in argv
+    argv = [a for a in argv if a != '--ram']
+    if len(argv) != 2:
+        sys.stderr.write(__doc__)
+        return 1
+    with open(argv[1]) as f:
+        regions, sections = parse(f)
+
+    used = {}
+    modules = {}
+    ramfuncs = []
+    for name, addr, size, module in sections:
+        region = region_of(regions, addr)
+        if region is None or size == 0:
+            continue
+        used[region] = used.get(region, 0) + size
+        key = (region, kind_of(name))
+        modules.setdefault(module, {})
+        modules[module][key] = modules[module].get(key, 0) + size
+        if kind_of(name) == 'ramfunc':
+            ramfuncs.append((size, name, module))
+
+    print('Memory regions')
+    for name, origin, length in regions:
+        if name == '*default*':
+            continue
+        u = used.get(name, 0)
+        print('  %-10s %7d / %7d bytes  %5.1f%%' % (name, u, length,
+                                                   100.0 * u / length))
+
+    columns = [('MFlash512', 'text'), ('RamLoc32', 'ramfunc'),
+               ('RamLoc32', 'data'), ('RamLoc32', 'bss'),
+               ('RamLoc32', 'noinit'), ('RamAHB32', 'data'),
+               ('RamAHB32', 'bss')]
+    print('')
+    print('%-44s %7s %7s %7s %7s %7s %7s %7s %7s' % ('module', 'flash',
+          'ramfunc', 'data', 'bss', 'noinit', 'ahbdata', 'ahbbss', 'ram'))
+    if by_ram:
+        rows = sorted(modules.items(), key=lambda kv: -ram_of(kv[1]))
+    else:
+        rows = sorted(modules.items(), key=lambda kv: -sum(kv[1].values()))
+    for module, sizes in rows:
+        print('%-44s %7d %7d %7d %7d %7d %7d %7d %7d' % ((module[-44:],) +
+              tuple(sizes.get(c, 0) for c in columns) + (ram_of(sizes),)))
+
+    # everything in RamLoc32 above the statics is stack (no heap is used)
+    print('')
+    print('RAM budget')
+    for name, origin, length in regions:
+        if not name.startswith('Ram'):
+            continue
+        u = used.get(name, 0)
+        if name == 'RamLoc32':
+            print('  %-10s %7d static, %7d left for the stack' %
+                  (name, u, length - u))
+        else:
+            print('  %-10s %7d static, %7d free' % (name, u, length - u))
+
+    if ramfuncs:
+        print('')
+        print('Executing from RAM')
+        for size, name, module in sorted(ramfuncs, reverse=True):
+            print('  %6d  %-32s %s' % (size, name, module))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))
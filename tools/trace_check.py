@@ -0,0 +1,198 @@
+#!/usr/bin/env python
+"""Cost metrics from .lpct traces and a regression check against a baseline.
+
+The trace is replayed in time order and the per period counters are
+accounted to the mode that was active, so a run that spends longer in one
+mode compares fairly. Metrics, overall and per mode:
+
+    loop_max      longest main loop pass, cycles
+    loop_p99      99th percentile of the per period longest pass, cycles
+    eeprom_pm     EEPROM bytes written per minute
+    display_ps    OLED bytes sent per second
+
+    python tools/trace_check.py summary run.lpct
+    python tools/trace_check.py baseline run.lpct baseline.json
+    python tools/trace_check.py check baseline.json run.lpct [--tolerance 10]
+
+check exits with 1 when any metric grows by more than the tolerance (in
+percent) over the baseline. --metrics eeprom_pm,display_ps limits baseline
+and check to the metrics named.
+
+With --replay the metrics come from the host build instead of the board:
+each trace's inputs and sensor samples are replayed through the firmware
+main loop by host/build/replay ("make -C host"), so a change can be
+checked against a baseline without hardware. Loop times are then host
+nanoseconds, so compare replayed runs only with a replayed baseline, and
+leave them out (--metrics) where the baseline is shared between machines
+as in "make -C host check".
+"""
+import json
+import os
+import subprocess
+import sys
+import tempfile
+
+import trace_format as tf
+
+METRICS = ('loop_max', 'loop_p99', 'eeprom_pm', 'display_ps')
+
+
+def percentile(values, pct):
+    if not values:
+        return 0
+    values = sorted(values)
+    return values[min(len(values) - 1, len(values) * pct // 100)]
+
+
+def replay(trace):
+    """Per mode accumulators from one trace."""
+    acc = {}
+    mode = 'all'
+    for tick, typ, ident, code, value in trace:
+        if typ == tf.MODE:
+            mode = 'mode%d' % ident
+            continue
+        if typ not in (tf.LOOP, tf.EEPROM, tf.DISPLAY):
+            continue
+        for key in ('all', mode):
+            a = acc.setdefault(key, {'loops': [], 'eeprom': 0,
+                                     'display': 0, 'periods': 0,
+                                     'dropped': 0})
+            if typ == tf.LOOP:
+                a['loops'].append(value)
+                a['periods'] += 1
+                a['dropped'] += ident
+            elif typ == tf.EEPROM:
+                a['eeprom'] += value
+            else:
+                a['display'] += value
+    return acc
+
+
+REPLAY = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                      '..', 'host', 'build', 'replay')
+
+
+def replayed(paths, tmpdir):
+    """Run each trace through the host build, return the traces it wrote."""
+    out = []
+    for i, path in enumerate(paths):
+        dest = os.path.join(tmpdir, '%d.lpct' % i)
+        with open(os.devnull, 'w') as null:
+            subprocess.check_call([REPLAY, path, dest], stdout=null)
+        out.append(dest)
+    return out
+
+
+def metrics(paths, replay_on_host=False):
+    if replay_on_host:
+        tmpdir = tempfile.mkdtemp()
+        try:
+            return metrics(replayed(paths, tmpdir))
+        finally:
+            for name in os.listdir(tmpdir):
+                os.remove(os.path.join(tmpdir, name))
+            os.rmdir(tmpdir)
+
+    merged = {}
+    for path in paths:
+        trace = tf.TraceFile(path)
+        for key, a in replay(trace).items():
+            m = merged.setdefault(key, {'loops': [], 'eeprom': 0,
+                                        'display': 0, 'periods': 0,
+                                        'dropped': 0})
+            for k in a:
+                m[k] += a[k]
+        trace.close()
+
+    result = {}
+    for key, a in merged.items():
+        seconds = a['periods'] * tf.PERIOD_MS / 1000.0
+        if seconds == 0:
+            continue
+        result[key] = {
+            'loop_max': max(a['loops']),
+            'loop_p99': percentile(a['loops'], 99),
+            'eeprom_pm': round(a['eeprom'] * 60.0 / seconds, 1),
+            'display_ps': round(a['display'] / seconds, 1),
+            'seconds': seconds,
+            'dropped': a['dropped'],
+        }
+    return result
+
+
+def print_metrics(result):
+    print('%-8s %9s %9s %10s %11s %8s %7s' % ('mode', 'loop_max',
+          'loop_p99', 'eeprom/min', 'display/s', 'seconds', 'dropped'))
+    for key in sorted(result):
+        r = result[key]
+        print('%-8s %9d %9d %10.1f %11.1f %8.1f %7d' % (key, r['loop_max'],
+              r['loop_p99'], r['eeprom_pm'], r['display_ps'], r['seconds'],
+              r['dropped']))
+
+
+def check(baseline, current, tolerance, names=METRICS):
+    failed = 0
+    for key in sorted(baseline):
+        if key not in current:
+            continue
+        for name in names:
+            # a baseline may hold only some of the metrics
+            if name not in baseline[key]:
+                continue
+            base = baseline[key][name]
+            now = current[key][name]
+            if now > base * (1 + tolerance / 100.0):
+                print('REGRESSION %s %s: %s -> %s' % (key, name, base, now))
+                failed = 1
+    return failed
+
+
+def main(argv):
+    args = argv[1:]
+    tolerance = 10.0
+    if '--tolerance' in args:
+        i = args.index('--tolerance')
+        tolerance = float(args[i + 1])
+        del args[i:i + 2]
+    names = METRICS
+    if '--metrics' in args:
+        i = args.index('--metrics')
+        names = tuple(args[i + 1].split(','))
+        del args[i:i + 2]
+        for name in names:
+            if name not in METRICS:
+                sys.stderr.write('unknown metric %s\n' % name)
+                return 2
+    host = '--replay' in args
+    if host:
+        args.remove('--replay')
+
+    if len(args) >= 2 and args[0] == 'summary':
+        print_metrics(metrics(args[1:], host))
+        return 0
+    if len(args) == 3 and args[0] == 'baseline':
+        result = metrics(args[1:2], host)
+        kept = dict((key, dict((name, r[name]) for name in names))
+                    for key, r in result.items())
+        with open(args[2], 'w') as f:
+            json.dump(kept, f, indent=1, sort_keys=True)
+            f.write('\n')
+        print_metrics(result)
+        return 0
+    if len(args) >= 3 and args[0] == 'check':
+        with open(args[1]) as f:
+            baseline = json.load(f)
+        current = metrics(args[2:], host)
+        print_metrics(current)
+        failed = check(baseline, current, tolerance, names)
+        if not failed:
+            print('OK within %g%%' % tolerance)
+        return failed
+
+    sys.stderr.write(__doc__)
+    return 2
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))
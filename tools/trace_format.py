@@ -0,0 +1,116 @@
+"""Trace format shared by trace_record.py and trace_check.py.
+
+Mirrors src/trace.h. A .lpct file is a 16 byte header followed by fixed
+12 byte records, all little endian, so it can be memory mapped and indexed
+directly:
+
+    header  char[4] 'LPCT', uint16 version, uint16 record size,
+            uint32 tick rate (Hz), uint32 record count
+    record  uint32 tick, uint8 type, uint8 id, uint16 code, int32 value
+
+On the UART every record is framed as SYNC, the 12 record bytes and the low
+byte of their sum.
+"""
+import mmap
+import struct
+
+MAGIC = b'LPCT'
+VERSION = 1
+TICK_HZ = 1000
+SYNC = 0xA5
+PERIOD_MS = 100
+
+HEADER = struct.Struct('<4sHHII')
+RECORD = struct.Struct('<IBBHi')
+FRAME_BYTES = RECORD.size + 2
+
+SAMPLE = 1
+INPUT = 2
+LOOP = 3
+EEPROM = 4
+DISPLAY = 5
+MODE = 6
+
+TYPE_NAMES = {SAMPLE: 'sample', INPUT: 'input', LOOP: 'loop',
+              EEPROM: 'eeprom', DISPLAY: 'display', MODE: 'mode'}
+
+
+class TraceFile(object):
+    """Read only, memory mapped view of a .lpct file."""
+
+    def __init__(self, path):
+        self._f = open(path, 'rb')
+        self._m = mmap.mmap(self._f.fileno(), 0, access=mmap.ACCESS_READ)
+        magic, version, size, self.tick_hz, count = \
+            HEADER.unpack_from(self._m, 0)
+        if magic != MAGIC or version != VERSION or size != RECORD.size:
+            raise ValueError('%s: not a version %d trace' % (path, VERSION))
+        # a recorder that was killed leaves the count at zero
+        avail = (len(self._m) - HEADER.size) // RECORD.size
+        self.count = count if 0 < count <= avail else avail
+
+    def __len__(self):
+        return self.count
+
+    def __getitem__(self, i):
+        if i < 0 or i >= self.count:
+            raise IndexError(i)
+        return RECORD.unpack_from(self._m, HEADER.size + i * RECORD.size)
+
+    def __iter__(self):
+        for i in range(self.count):
+            yield RECORD.unpack_from(self._m, HEADER.size + i * RECORD.size)
+
+    def close(self):
+        self._m.close()
+        self._f.close()
+
+
+class TraceWriter(object):
+    """Append records to a new .lpct file; close() stores the count."""
+
+    def __init__(self, path):
+        self._f = open(path, 'wb')
+        self.count = 0
+        self._f.write(HEADER.pack(MAGIC, VERSION, RECORD.size, TICK_HZ, 0))
+
+    def write(self, rec):
+        self._f.write(RECORD.pack(*rec))
+        self.count += 1
+
+    def close(self):
+        self._f.seek(0)
+        self._f.write(HEADER.pack(MAGIC, VERSION, RECORD.size, TICK_HZ,
+                                  self.count))
+        self._f.close()
+
+
+class FrameDecoder(object):
+    """Turn UART bytes into records, resynchronizing on bad frames.
+
+    Anything that is not a frame (e.g. the CSV the diagnostics mode
+    exports) is skipped and counted in self.skipped.
+    """
+
+    def __init__(self):
+        self._buf = bytearray()
+        self.skipped = 0
+
+    def feed(self, data):
+        self._buf.extend(bytearray(data))
+        out = []
+        i = 0
+        while len(self._buf) - i >= FRAME_BYTES:
+            if self._buf[i] != SYNC:
+                i += 1
+                self.skipped += 1
+                continue
+            body = self._buf[i + 1:i + 1 + RECORD.size]
+            if sum(body) & 0xFF != self._buf[i + FRAME_BYTES - 1]:
+                i += 1
+                self.skipped += 1
+                continue
+            out.append(RECORD.unpack(bytes(body)))
+            i += FRAME_BYTES
+        del self._buf[:i]
+        return out
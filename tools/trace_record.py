@@ -0,0 +1,45 @@
+#!/usr/bin/env python
+"""Record the board's trace stream into a .lpct file.
+
+Tracing is toggled on the board with joystick up in the diagnostics mode
+(a T shows in the header). Stop recording with Ctrl-C. Needs pyserial.
+
+    python tools/trace_record.py COM5 run.lpct
+    python tools/trace_record.py --seconds 60 /dev/ttyUSB0 run.lpct
+"""
+import sys
+import time
+
+import trace_format as tf
+
+
+def main(argv):
+    args = argv[1:]
+    seconds = None
+    if len(args) >= 2 and args[0] == '--seconds':
+        seconds = float(args[1])
+        args = args[2:]
+    if len(args) != 2:
+        sys.stderr.write(__doc__)
+        return 2
+
+    import serial
+    port = serial.Serial(args[0], 115200, timeout=0.2)
+    out = tf.TraceWriter(args[1])
+    dec = tf.FrameDecoder()
+    start = time.time()
+    try:
+        while seconds is None or time.time() - start < seconds:
+            for rec in dec.feed(port.read(4096)):
+                out.write(rec)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        out.close()
+        port.close()
+    print('%d records, %d bytes skipped' % (out.count, dec.skipped))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))